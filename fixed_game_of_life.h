@@ -0,0 +1,302 @@
+#ifndef FixedGameOfLife_H_DEFINED
+#define FixedGameOfLife_H_DEFINED
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "game_of_life.h"
+
+namespace GOL {
+/**
+ * class FixedGameOfLife<W, H>
+ *
+ * A game of life board whose width W and height H are fixed at compile time.
+ * Cells live in an inline std::array, so the object needs no heap storage and
+ * can be kept on the stack or packed densely into arrays. Row and column
+ * wrap around fold to bit masks when W or H is a power of two, and every loop
+ * bound is a constant the compiler can unroll.
+ *
+ * It supports the stepping and output operators of GameOfLife ('+=', '++'
+ * and '<<') but keeps no history, so it cannot be rolled back.
+ *
+ * @author Trevor Chartier
+ */
+template <int W, int H> class FixedGameOfLife {
+  static_assert(W > 0 && H > 0, "board dimensions must be positive");
+
+  /**
+   * std::array<uint8_t, W * H> cells_, 1 for every live cell and 0 for every
+   * dead cell, stored row by row
+   */
+  std::array<std::uint8_t, W * H> cells_{};
+
+  /**
+   * char live_cell_, this represents the character to display for live cells
+   * in the game board
+   */
+  char live_cell_ = '*';
+
+  /**
+   * char dead_cell_, this represents the character to display for dead cells
+   * in the game board
+   */
+  char dead_cell_ = '-';
+
+  /**
+   * int generations_, this integer stores the value for the current
+   * generation that the game board is on (starting from 0)
+   */
+  int generations_ = 0;
+
+public:
+  /**
+   * FixedGameOfLife()
+   * Default constructor, creates a board where every cell is dead
+   */
+  constexpr FixedGameOfLife() = default;
+
+  /**
+   * FixedGameOfLife(const GameOfLife &game)
+   * Conversion constructor, copies the current board, cell characters and
+   * generation count of a GameOfLife object
+   *
+   * @throws range error if game is not W x H
+   */
+  explicit FixedGameOfLife(const GameOfLife &game) {
+    if (game.GetWidth() != W || game.GetHeight() != H) {
+      throw std::range_error(
+          "\nError\nFile: fixed_game_of_life.h \nFunction: "
+          "FixedGameOfLife(const GameOfLife &game)\nA " +
+          std::to_string(game.GetHeight()) + "x" +
+          std::to_string(game.GetWidth()) + " board cannot be stored in a " +
+          std::to_string(H) + "x" + std::to_string(W) + " FixedGameOfLife.");
+    }
+    for (int row = 0; row < H; ++row) {
+      for (int col = 0; col < W; ++col) {
+        this->cells_[row * W + col] = game.IsAlive(row, col) ? 1 : 0;
+      }
+    }
+    this->live_cell_ = game.GetLiveCell();
+    this->dead_cell_ = game.GetDeadCell();
+    this->generations_ = game.GetGenerations();
+  }
+
+  /**
+   * GetGenerations()
+   * Retreives the number of generation calculations that the board has gone
+   * through
+   */
+  constexpr int GetGenerations() const { return this->generations_; }
+
+  /**
+   * GetWidth()
+   * Returns the number of columns in the game board
+   */
+  static constexpr int GetWidth() { return W; }
+
+  /**
+   * GetHeight()
+   * Returns the number of rows in the game board
+   */
+  static constexpr int GetHeight() { return H; }
+
+  /**
+   * SetLiveCell(char live_cell)
+   * Changes the character for the Live Cell
+   *
+   * @throws Runtime Error if live_cell is the current dead cell character
+   */
+  void SetLiveCell(char live_cell) {
+    if (live_cell == this->dead_cell_) {
+      throw std::runtime_error(
+          "\nError \nFile: fixed_game_of_life.h\nFunction: SetLiveCell\nLive "
+          "Cell character cannot be set the same as current Dead Cell "
+          "character");
+    }
+    this->live_cell_ = live_cell;
+  }
+
+  /**
+   * SetDeadCell(char dead_cell)
+   * Changes the character for the Dead Cell
+   *
+   * @throws Runtime Error if dead_cell is the current live cell character
+   */
+  void SetDeadCell(char dead_cell) {
+    if (dead_cell == this->live_cell_) {
+      throw std::runtime_error(
+          "\nError\nFile: fixed_game_of_life.h\nFunction: SetDeadCell\nDead "
+          "Cell character cannot be set the same as current Live Cell "
+          "character");
+    }
+    this->dead_cell_ = dead_cell;
+  }
+
+  /**
+   * bool IsAlive(int row, int col)
+   * Checks whether the cell at row,col is alive
+   *
+   * @throws range error if either row or col is out of bounds
+   */
+  bool IsAlive(int row, int col) const {
+    CheckCell(row, col, "IsAlive");
+    return this->cells_[row * W + col] != 0;
+  }
+
+  /**
+   * void ToggleCell(int row, int col)
+   * This method sets a live cell at row,col to dead and vice-versa
+   *
+   * @throws range error if either row or col is out of bounds
+   */
+  void ToggleCell(int row, int col) {
+    CheckCell(row, col, "ToggleCell");
+    this->cells_[row * W + col] ^= 1;
+  }
+
+  /**
+   * operator+=(int N)
+   * Calculates the next N generations on the current board and returns it
+   *
+   * @throws domain error if N is negative, as there is no history to roll
+   * back to
+   */
+  FixedGameOfLife &operator+=(int N) {
+    if (N < 0) {
+      throw std::domain_error(
+          "\nError\nFile: fixed_game_of_life.h \nFunction: operator "
+          "+=\nFixedGameOfLife keeps no history to roll back to");
+    }
+    while (N > 0) {
+      NextGen();
+      --N;
+    }
+    return *this;
+  }
+
+  /**
+   * operator+(int N)
+   * Returns what the board would be in N generations
+   *
+   * @throws domain error if N is negative
+   */
+  FixedGameOfLife operator+(int N) const {
+    FixedGameOfLife copy = *this;
+    copy += N;
+    return copy;
+  }
+
+  /**
+   * operator++()
+   * The preincrement operator calculates next generation on the current board
+   * and returns itself
+   */
+  FixedGameOfLife &operator++() {
+    NextGen();
+    return *this;
+  }
+
+  /**
+   * operator++(int)
+   * The postincrement operator calculates the next generation on the current
+   * board but returns a copy of itself before the increment
+   */
+  FixedGameOfLife operator++(int) {
+    FixedGameOfLife copy = *this;
+    NextGen();
+    return copy;
+  }
+
+  /**
+   * bool Equals(const FixedGameOfLife &other)
+   * Returns true if every cell has the same live/dead state on both boards
+   */
+  bool Equals(const FixedGameOfLife &other) const {
+    return this->cells_ == other.cells_;
+  }
+
+  /**
+   * NextGen()
+   * @brief Calculates the next generation with wrap around and sets it as the
+   * new state of the board.
+   *
+   * Neighbor counts are built from column sums of three rows at a time, so
+   * every cell costs three additions instead of eight lookups
+   */
+  void NextGen() {
+    std::array<std::uint8_t, W * H> next;
+    std::array<std::uint8_t, W> column_sums;
+    for (int row = 0; row < H; ++row) {
+      const std::uint8_t *up = &this->cells_[Wrap<H>(row - 1) * W];
+      const std::uint8_t *mid = &this->cells_[row * W];
+      const std::uint8_t *down = &this->cells_[Wrap<H>(row + 1) * W];
+      for (int col = 0; col < W; ++col) {
+        column_sums[col] = up[col] + mid[col] + down[col];
+      }
+      for (int col = 0; col < W; ++col) {
+        // The neighborhood sum includes the cell itself
+        int total = column_sums[Wrap<W>(col - 1)] + column_sums[col] +
+                    column_sums[Wrap<W>(col + 1)];
+        next[row * W + col] = (total == 3 || (total == 4 && mid[col])) ? 1 : 0;
+      }
+    }
+    this->cells_ = next;
+    this->generations_++;
+  }
+
+private:
+  /**
+   * Wrap<N>(int value)
+   * Wraps a row or column that is at most one step off the board back onto
+   * it. Folds to a bit mask when N is a power of two
+   */
+  template <int N> static constexpr int Wrap(int value) {
+    if constexpr ((N & (N - 1)) == 0) {
+      return value & (N - 1);
+    } else {
+      return value < 0 ? value + N : (value >= N ? value - N : value);
+    }
+  }
+
+  /**
+   * CheckCell(int row, int col, const char *function)
+   * Validates that row,col lies on the board
+   *
+   * @throws range error naming function if it does not
+   */
+  static void CheckCell(int row, int col, const char *function) {
+    if (row < 0 || row >= H || col < 0 || col >= W) {
+      throw std::range_error("\nError\nFile: fixed_game_of_life.h \nFunction: " +
+                             std::string(function) + "\nThe cell at " +
+                             std::to_string(row) + "," + std::to_string(col) +
+                             " is out of bounds.");
+    }
+  }
+
+  template <int OW, int OH>
+  friend std::ostream &operator<<(std::ostream &os,
+                                  const FixedGameOfLife<OW, OH> &game);
+};
+
+/**
+ * @brief Output the gameboard to ostream
+ *
+ * Write the generation count and the gameboard grid to ostream in the same
+ * format as GameOfLife
+ */
+template <int W, int H>
+std::ostream &operator<<(std::ostream &os, const FixedGameOfLife<W, H> &game) {
+  os << "Generation: " << game.GetGenerations() << '\n';
+  for (int row = 0; row < H; ++row) {
+    for (int col = 0; col < W; ++col) {
+      os << (game.cells_[row * W + col] ? game.live_cell_ : game.dead_cell_);
+    }
+    os << '\n';
+  }
+  return os;
+}
+} // namespace GOL
+
+#endif
@@ -1,9 +1,11 @@
 #include "game_of_life.h"
 
 #include <algorithm>
-#include <array>
+#include <bit>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <string>
 
@@ -11,6 +13,16 @@ using namespace std;
 using namespace GOL;
 //@author Trevor Chartier
 
+namespace {
+
+/**
+ * Roughly how many cells CalcNextBoard calculates between checks of the
+ * deadline and cancellation token
+ */
+constexpr std::int64_t kCellsPerCheck = 1 << 14;
+
+} // namespace
+
 game_save_state::game_save_state(std::string game_board_param, char live_param,
                                  char dead_param)
     : game_board(game_board_param), live(live_param), dead(dead_param) {}
@@ -57,10 +69,10 @@ GameOfLife::GameOfLife(string filename, char live_cell, char dead_cell,
           line); // Skipping the end of the first line to get to the data
 
   // For all rows in the file
-  for (int row = 0; row < this->height_; ++row) {
+  for (std::int64_t row = 0; row < this->height_; ++row) {
     getline(file_in, line);
     // For all Columns in the row
-    for (int col = 0; col < this->width_; ++col) {
+    for (std::int64_t col = 0; col < this->width_; ++col) {
       if (line[col] == '*') {
         size_t index = ConvertTo1D(row, col);
         this->current_[index] = '*';
@@ -71,6 +83,15 @@ GameOfLife::GameOfLife(string filename, char live_cell, char dead_cell,
   NextNGen(generation_count);
 }
 
+GameOfLife::GameOfLife(std::int64_t width, std::int64_t height)
+    : live_cell_('*'), dead_cell_('-'), width_(width), height_(height) {
+  if (width <= 0 || height <= 0) {
+    throw(runtime_error("Error in GameOfLife constructor: width and height "
+                        "must both be positive"));
+  }
+  this->current_ = std::string(this->width_ * this->height_, '-');
+}
+
 void GameOfLife::SetLiveCell(char live_cell) {
   if (live_cell == this->dead_cell_) {
     throw(runtime_error(
@@ -129,6 +150,7 @@ GameOfLife &GameOfLife::operator-=(int N) {
   this->dead_cell_ = prev.dead;
   this->generations_ = prev_gen_num;
   this->rollback_limit_ -= N;
+  BoardChanged();
 
   return *this;
 }
@@ -157,12 +179,66 @@ GameOfLife GameOfLife::operator--(int) {
 
 GameOfLife GameOfLife::operator-() {
   GameOfLife copy = GameOfLife(*this);
-  for(size_t i = 0; i < copy.current_.size(); ++i){
-    copy.ToggleCell(i);
-  }
+  std::transform(copy.current_.begin(), copy.current_.end(),
+                 copy.current_.begin(),
+                 [](char cell) { return (cell == '*') ? '-' : '*'; });
+  copy.BoardChanged();
   return copy;
 }
 
+GameOfLife GameOfLife::operator&(const GameOfLife &other) const {
+  GameOfLife copy = GameOfLife(*this);
+  return copy.Combine(other, paste_mode::kAnd, "operator&");
+}
+
+GameOfLife GameOfLife::operator|(const GameOfLife &other) const {
+  GameOfLife copy = GameOfLife(*this);
+  return copy.Combine(other, paste_mode::kOr, "operator|");
+}
+
+GameOfLife GameOfLife::operator^(const GameOfLife &other) const {
+  GameOfLife copy = GameOfLife(*this);
+  return copy.Combine(other, paste_mode::kXor, "operator^");
+}
+
+GameOfLife GameOfLife::AndNot(const GameOfLife &other) const {
+  GameOfLife copy = GameOfLife(*this);
+  return copy.Combine(other, paste_mode::kAndNot, "AndNot");
+}
+
+GameOfLife &GameOfLife::operator&=(const GameOfLife &other) {
+  return Combine(other, paste_mode::kAnd, "operator&=");
+}
+
+GameOfLife &GameOfLife::operator|=(const GameOfLife &other) {
+  return Combine(other, paste_mode::kOr, "operator|=");
+}
+
+GameOfLife &GameOfLife::operator^=(const GameOfLife &other) {
+  return Combine(other, paste_mode::kXor, "operator^=");
+}
+
+GameOfLife &GameOfLife::AndNotAssign(const GameOfLife &other) {
+  return Combine(other, paste_mode::kAndNot, "AndNotAssign");
+}
+
+void GameOfLife::Translate(std::int64_t rows, std::int64_t cols) {
+  rows = ((rows % this->height_) + this->height_) % this->height_;
+  cols = ((cols % this->width_) + this->width_) % this->width_;
+  // Rotating the whole board moves rows, rotating each row moves columns
+  std::rotate(this->current_.begin(),
+              this->current_.end() - rows * this->width_,
+              this->current_.end());
+  if (cols != 0) {
+    for (std::int64_t row = 0; row < this->height_; ++row) {
+      auto row_begin = this->current_.begin() + ConvertTo1D(row, 0);
+      auto row_end = row_begin + this->width_;
+      std::rotate(row_begin, row_end - cols, row_end);
+    }
+  }
+  BoardChanged();
+}
+
 bool GameOfLife::operator==(const GameOfLife &other) const {
   double difference = (this->CalcPercentLiving() - other.CalcPercentLiving());
   if (std::abs(difference) < 0.005) {
@@ -199,10 +275,49 @@ bool GameOfLife::operator>=(const GameOfLife &other) const {
   return false;
 }
 
+bool GameOfLife::Equals(const GameOfLife &other) const {
+  if (this->width_ != other.width_ || this->height_ != other.height_) {
+    return false;
+  }
+  // Only use the hashes if they are already known
+  if (this->hash_.valid && other.hash_.valid &&
+      Hash() != other.Hash()) {
+    return false;
+  }
+  return this->current_ == other.current_;
+}
+
+std::uint64_t GameOfLife::Hash() const {
+  if (!this->hash_.valid) {
+    std::lock_guard<std::mutex> lock(this->hash_.mutex);
+    if (!this->hash_.valid) {
+      this->hash_.value = SegmentHash(0, this->current_.size());
+      this->hash_.valid = true;
+    }
+  }
+  std::uint64_t dimensions =
+      (static_cast<std::uint64_t>(this->width_) << 32) ^
+      static_cast<std::uint64_t>(this->height_);
+  return this->hash_.value ^ CellKey(~dimensions);
+}
+
+std::uint64_t GameOfLife::VerifyHash() const {
+  // Hash() keys cells by index, so keying them by ~index keeps the two apart
+  std::uint64_t hash =
+      CellKey((static_cast<std::uint64_t>(this->width_) << 32) ^
+              static_cast<std::uint64_t>(this->height_));
+  for (size_t i = 0; i < this->current_.size(); ++i) {
+    if (Alive(i)) {
+      hash ^= CellKey(~i);
+    }
+  }
+  return hash;
+}
+
 double GameOfLife::CalcPercentLiving() const {
-  int size = this->current_.length();
+  size_t size = this->current_.length();
   double numAlive = 0.0;
-  for (int i = 0; i < size; ++i) {
+  for (size_t i = 0; i < size; ++i) {
     if (Alive(i)) {
       ++numAlive;
     }
@@ -214,10 +329,30 @@ bool GameOfLife::IsStillLife() const {
   return this->current_ == (*this + 1).current_;
 }
 
-void GameOfLife::ToggleCell(int index) {
-  if (index < 0 || index >= static_cast<int>(this->current_.size())) {
+std::int64_t GameOfLife::CountAlive(std::int64_t row, std::int64_t col,
+                                    std::int64_t rows,
+                                    std::int64_t cols) const {
+  CheckRegion(row, col, rows, cols, "CountAlive");
+  if (!this->alive_table_.valid) {
+    BuildAliveTable();
+  }
+  // Split the window at the bottom and right edges into up to four pieces
+  std::int64_t top_rows = std::min(rows, this->height_ - row);
+  std::int64_t left_cols = std::min(cols, this->width_ - col);
+  std::int64_t wrap_rows = rows - top_rows;
+  std::int64_t wrap_cols = cols - left_cols;
+
+  return CountAliveInBounds(row, col, top_rows, left_cols) +
+         CountAliveInBounds(row, 0, top_rows, wrap_cols) +
+         CountAliveInBounds(0, col, wrap_rows, left_cols) +
+         CountAliveInBounds(0, 0, wrap_rows, wrap_cols);
+}
+
+void GameOfLife::ToggleCell(std::int64_t index) {
+  if (index < 0 ||
+      index >= static_cast<std::int64_t>(this->current_.size())) {
     throw range_error("\nError\nFile: game_of_life.cpp \nFunction: "
-                      "ToggleCell(int index) \nThe cell at index " +
+                      "ToggleCell(int64_t index) \nThe cell at index " +
                       to_string(index) +
                       " cannot be toggled as it is out of bounds.");
   }
@@ -226,139 +361,681 @@ void GameOfLife::ToggleCell(int index) {
   } else {
     this->current_[index] = '*';
   }
+  BoardChanged();
 }
 
-void GameOfLife::ToggleCell(int row, int col) {
+void GameOfLife::ToggleCell(std::int64_t row, std::int64_t col) {
   if (row < 0 || row >= this->height_) {
     throw range_error("\nError\nFile: game_of_life.cpp \nFunction: "
-                      "ToggleCell(int row, int col)\nRow " +
+                      "ToggleCell(int64_t row, int64_t col)\nRow " +
                       to_string(row) + " is out of bounds.");
   }
   if (col < 0 || col >= this->width_) {
     throw range_error("\nError\nFile: game_of_life.cpp\nFunction: "
-                      "ToggleCell(int row, int col)\nColumn " +
+                      "ToggleCell(int64_t row, int64_t col)\nColumn " +
                       to_string(col) + " is out of bounds.");
   }
   ToggleCell(ConvertTo1D(row,col));
 }
 
+bool GameOfLife::IsAlive(std::int64_t row, std::int64_t col) const {
+  const cell_coord cell(row, col);
+  CheckCells(std::span<const cell_coord>(&cell, 1), "IsAlive");
+  return Alive(ConvertTo1D(row, col));
+}
+
+std::vector<cell_coord> GameOfLife::LiveCells() const {
+  std::vector<cell_coord> cells;
+  for (std::int64_t row = 0; row < this->height_; ++row) {
+    const char *row_begin = this->current_.data() + ConvertTo1D(row, 0);
+    for (std::int64_t col = 0; col < this->width_; ++col) {
+      if (row_begin[col] == '*') {
+        cells.emplace_back(row, col);
+      }
+    }
+  }
+  return cells;
+}
+
+void GameOfLife::SetCells(std::span<const cell_coord> cells) {
+  CheckCells(cells, "SetCells");
+  for (const cell_coord &cell : cells) {
+    size_t index = ConvertTo1D(cell.first, cell.second);
+    this->current_[index] = '*';
+  }
+  BoardChanged();
+}
+
+void GameOfLife::ClearCells(std::span<const cell_coord> cells) {
+  CheckCells(cells, "ClearCells");
+  for (const cell_coord &cell : cells) {
+    size_t index = ConvertTo1D(cell.first, cell.second);
+    this->current_[index] = '-';
+  }
+  BoardChanged();
+}
+
+void GameOfLife::ToggleCells(std::span<const cell_coord> cells) {
+  CheckCells(cells, "ToggleCells");
+  for (const cell_coord &cell : cells) {
+    size_t index = ConvertTo1D(cell.first, cell.second);
+    this->current_[index] = Alive(index) ? '-' : '*';
+  }
+  BoardChanged();
+}
+
+void GameOfLife::FillRect(std::int64_t row, std::int64_t col,
+                          std::int64_t rows, std::int64_t cols, bool alive) {
+  CheckRegion(row, col, rows, cols, "FillRect");
+  const char fill = alive ? '*' : '-';
+  // Each row of the rectangle is at most two memsets: up to the right edge,
+  // then the part that wraps back to column 0
+  std::int64_t first_len = std::min(cols, this->width_ - col);
+  for (std::int64_t r = 0; r < rows; ++r) {
+    std::int64_t dest_row = (row + r) % this->height_;
+    std::memset(this->current_.data() + ConvertTo1D(dest_row, col), fill,
+                first_len);
+    if (first_len < cols) {
+      std::memset(this->current_.data() + ConvertTo1D(dest_row, 0), fill,
+                  cols - first_len);
+    }
+  }
+  BoardChanged();
+}
+
+void GameOfLife::Paste(const GameOfLife &pattern, std::int64_t row,
+                       std::int64_t col, paste_mode mode) {
+  CheckRegion(row, col, pattern.height_, pattern.width_, "Paste");
+  // Pasting a board onto itself would read rows that were already written,
+  // so read from a snapshot of the board instead
+  const std::string *source = &pattern.current_;
+  std::string snapshot;
+  if (&pattern == this) {
+    snapshot = this->current_;
+    source = &snapshot;
+  }
+  for (std::int64_t r = 0; r < pattern.height_; ++r) {
+    BlitRow((row + r) % this->height_, col,
+            source->data() + pattern.ConvertTo1D(r, 0), pattern.width_, mode);
+  }
+  BoardChanged();
+}
+
 void GameOfLife::NextNGen(int n) {
+  // Only the last 100 generations can be rolled back to, so anything before
+  // them is stepped without saving. The saved generations then fill the whole
+  // history, which keeps rollback_limit_ correct
+  while (n > 100) {
+    StepBoard();
+    --n;
+  }
   while (n > 0) {
     NextGen();
     --n;
   }
 }
 
+void GameOfLife::NextNGenWithoutHistory(int n) {
+  if (n <= 0) {
+    return;
+  }
+  while (n > 0) {
+    StepBoard();
+    --n;
+  }
+  this->rollback_limit_ = 0;
+}
+
 void GameOfLife::NextGen() {
   // Save current game state prior to incrementing
+  SaveGeneration();
+  StepBoard();
+}
+
+void GameOfLife::SaveGeneration() {
   game_save_state curr_state(this->current_, this->live_cell_,
                              this->dead_cell_);
   this->previous_generations_[this->generations_ % 100] = curr_state;
   if (this->rollback_limit_ < 100)
     ++this->rollback_limit_;
+}
 
-  std::string TO;
-  TO.resize(this->current_.size());
+std::vector<pattern_match> GameOfLife::FindPattern(const GameOfLife &pattern,
+                                                   unsigned orientations) const {
+  return FindPattern(pattern, orientations, false);
+}
 
-  for (size_t i = 0; i < this->current_.size(); ++i) {
-    if (AliveNextGen(i)) {
-      TO[i] = '*';
-    } else {
-      TO[i] = '-';
+std::vector<pattern_match> GameOfLife::FindPattern(const GameOfLife &pattern,
+                                                   unsigned orientations,
+                                                   bool isolated) const {
+  // Build each requested orientation once, skipping duplicates of symmetric
+  // patterns. An isolated search pads the pattern with a ring of dead cells
+  std::vector<std::pair<pattern_orientation, std::vector<std::string>>> variants;
+  for (unsigned bit = kIdentity; bit <= kFlipAntiDiagonal; bit <<= 1) {
+    if (!(orientations & bit)) {
+      continue;
+    }
+    pattern_orientation orientation = static_cast<pattern_orientation>(bit);
+    std::vector<std::string> rows = pattern.OrientedRows(orientation);
+    if (isolated) {
+      for (std::string &row : rows) {
+        row = '-' + row + '-';
+      }
+      rows.insert(rows.begin(), std::string(rows[0].size(), '-'));
+      rows.push_back(std::string(rows[0].size(), '-'));
+    }
+    if (static_cast<std::int64_t>(rows.size()) > this->height_ ||
+        static_cast<std::int64_t>(rows[0].size()) > this->width_) {
+      throw range_error("\nError\nFile: game_of_life.cpp \nFunction: "
+                        "FindPattern\nA " + to_string(rows.size()) + "x" +
+                        to_string(rows[0].size()) +
+                        " pattern does not fit on the board.");
+    }
+    bool duplicate = false;
+    for (const auto &variant : variants) {
+      duplicate = duplicate || variant.second == rows;
     }
+    if (!duplicate) {
+      variants.emplace_back(orientation, std::move(rows));
+    }
+  }
+
+  // Anchor each variant on its first live cell. A match can only start where
+  // a live board cell lines up with that anchor, so the board is scanned once
+  // for live cells and only those candidates are checked. A variant with no
+  // live cells has no anchor and is checked everywhere
+  std::vector<std::pair<std::int64_t, std::int64_t>> anchors;
+  for (const auto &variant : variants) {
+    std::pair<std::int64_t, std::int64_t> anchor(-1, -1);
+    for (size_t r = 0; r < variant.second.size() && anchor.first < 0; ++r) {
+      size_t c = variant.second[r].find('*');
+      if (c != std::string::npos) {
+        anchor = {r, c};
+      }
+    }
+    anchors.push_back(anchor);
+  }
+
+  std::int64_t offset = isolated ? 1 : 0;
+  std::vector<pattern_match> matches;
+  auto check = [&](size_t v, std::int64_t row, std::int64_t col) {
+    if (MatchesAt(variants[v].second, row, col)) {
+      matches.push_back({(row + offset) % this->height_,
+                         (col + offset) % this->width_, variants[v].first});
+    }
+  };
+
+  // Rows of at most 8 cells are also kept as (cells, mask) words so that a
+  // candidate away from the edges is checked with one 8-byte load per row and
+  // no branches
+  std::vector<std::vector<std::pair<std::uint64_t, std::uint64_t>>> words(
+      variants.size());
+  for (size_t v = 0; v < variants.size(); ++v) {
+    for (const std::string &pattern_row : variants[v].second) {
+      if (pattern_row.size() > 8) {
+        words[v].clear();
+        break;
+      }
+      char cells[8] = {};
+      char mask[8] = {};
+      std::memcpy(cells, pattern_row.data(), pattern_row.size());
+      std::memset(mask, -1, pattern_row.size());
+      std::pair<std::uint64_t, std::uint64_t> word;
+      std::memcpy(&word.first, cells, sizeof(word.first));
+      std::memcpy(&word.second, mask, sizeof(word.second));
+      words[v].push_back(word);
+    }
+  }
+
+  // Checks every anchored variant against the live cell at row,col
+  const char *board_begin = this->current_.data();
+  size_t board_size = this->current_.size();
+  auto check_live = [&](std::int64_t row, std::int64_t col) {
+    for (size_t v = 0; v < variants.size(); ++v) {
+      if (anchors[v].first < 0) {
+        continue;
+      }
+      std::int64_t top = row - anchors[v].first;
+      std::int64_t left = col - anchors[v].second;
+      std::int64_t rows = variants[v].second.size();
+      std::int64_t cols = variants[v].second[0].size();
+      bool in_bounds = top >= 0 && top + rows <= this->height_ && left >= 0 &&
+                       left + cols <= this->width_ &&
+                       ConvertTo1D(top + rows - 1, left) + 8 <= board_size;
+      if (words[v].empty() || !in_bounds) {
+        // Wide patterns and candidates that wrap around an edge, or whose
+        // last 8-byte load would run off the board, take the general check
+        check(v, (top + this->height_) % this->height_,
+              (left + this->width_) % this->width_);
+        continue;
+      }
+      std::uint64_t difference = 0;
+      const char *cells = board_begin + ConvertTo1D(top, left);
+      for (const auto &[expected, mask] : words[v]) {
+        std::uint64_t board;
+        std::memcpy(&board, cells, sizeof(board));
+        difference |= (board ^ expected) & mask;
+        cells += this->width_;
+      }
+      if (difference == 0) {
+        matches.push_back({(top + offset) % this->height_,
+                           (left + offset) % this->width_,
+                           variants[v].first});
+      }
+    }
+  };
+
+  for (std::int64_t row = 0; row < this->height_; ++row) {
+    const char *row_begin = this->current_.data() + ConvertTo1D(row, 0);
+    // Find live cells eight at a time. Cells are only '*' or '-', so XOR with
+    // '*' leaves 0 in each live byte and 7 in each dead one, and adding 0x7f
+    // then sets a byte's top bit exactly when its cell is dead
+    std::int64_t col = 0;
+    for (; col + 8 <= this->width_; col += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, row_begin + col, sizeof(word));
+      std::uint64_t live =
+          (((word ^ 0x2a2a2a2a2a2a2a2a) + 0x7f7f7f7f7f7f7f7f) &
+           0x8080808080808080) ^
+          0x8080808080808080;
+      while (live != 0) {
+        // The first cell in memory is the low byte on little-endian machines
+        int bit = (std::endian::native == std::endian::little)
+                      ? std::countr_zero(live)
+                      : 63 - std::countl_zero(live);
+        int byte = (std::endian::native == std::endian::little)
+                       ? bit / 8
+                       : 7 - bit / 8;
+        check_live(row, col + byte);
+        live ^= std::uint64_t{1} << bit;
+      }
+    }
+    for (; col < this->width_; ++col) {
+      if (row_begin[col] == '*') {
+        check_live(row, col);
+      }
+    }
+    for (size_t v = 0; v < variants.size(); ++v) {
+      if (anchors[v].first < 0) {
+        for (std::int64_t c = 0; c < this->width_; ++c) {
+          check(v, row, c);
+        }
+      }
+    }
+  }
+
+  // The ring offset can move matches across the first row or column
+  std::sort(matches.begin(), matches.end(),
+            [](const pattern_match &a, const pattern_match &b) {
+              if (a.row != b.row) {
+                return a.row < b.row;
+              }
+              if (a.col != b.col) {
+                return a.col < b.col;
+              }
+              return a.orientation < b.orientation;
+            });
+  return matches;
+}
+
+int GameOfLife::StepFor(std::chrono::steady_clock::duration budget) {
+  return StepWithin(DeadlineAfter(budget), numeric_limits<int>::max(),
+                    nullptr);
+}
+
+int GameOfLife::StepFor(std::chrono::steady_clock::duration budget,
+                        const CancellationToken &token) {
+  return StepWithin(DeadlineAfter(budget), numeric_limits<int>::max(),
+                    &token);
+}
+
+std::chrono::steady_clock::time_point
+GameOfLife::DeadlineAfter(std::chrono::steady_clock::duration budget) {
+  using clock = std::chrono::steady_clock;
+  clock::time_point now = clock::now();
+  // Saturate instead of overflowing for very large or negative budgets
+  if (budget <= clock::duration::zero()) {
+    return now;
+  }
+  if (budget > clock::time_point::max() - now) {
+    return clock::time_point::max();
   }
+  return now + budget;
+}
 
-  this->current_ = TO;
+int GameOfLife::StepUntil(std::chrono::steady_clock::time_point deadline,
+                          int max_gens) {
+  return StepWithin(deadline, max_gens, nullptr);
+}
+
+int GameOfLife::StepUntil(std::chrono::steady_clock::time_point deadline,
+                          int max_gens, const CancellationToken &token) {
+  return StepWithin(deadline, max_gens, &token);
+}
+
+int GameOfLife::StepWithin(std::chrono::steady_clock::time_point deadline,
+                           int max_gens, const CancellationToken *token) {
+  using clock = std::chrono::steady_clock;
+  int completed = 0;
+  clock::time_point now = clock::now();
+  clock::duration last_gen = clock::duration::zero();
+
+  // The previous generation's duration predicts whether the next one still
+  // fits. CalcNextBoard also checks the clock and token as it goes, and the
+  // board only advances once a whole generation has been calculated
+  while (completed < max_gens && now + last_gen <= deadline) {
+    if (!CalcNextBoard(this->next_.cells, deadline, token)) {
+      break;
+    }
+    SaveGeneration();
+    this->current_.swap(this->next_.cells);
+    this->generations_++;
+    BoardChanged();
+    ++completed;
+    clock::time_point finished = clock::now();
+    last_gen = finished - now;
+    now = finished;
+  }
+  return completed;
+}
+
+void GameOfLife::StepBoard() {
+  CalcNextBoard(this->next_.cells, std::chrono::steady_clock::time_point::max(),
+                nullptr);
+
+  this->current_.swap(this->next_.cells);
   this->generations_++;
+  BoardChanged();
 }
 
-bool GameOfLife::AliveNextGen(size_t index) {
-  int num_live_neighbors = CalcNumLiveNeighbors(index);
+bool GameOfLife::CalcNextBoard(std::string &next,
+                               std::chrono::steady_clock::time_point deadline,
+                               const CancellationToken *token) {
+  using clock = std::chrono::steady_clock;
+  next.resize(this->current_.size());
+  bool checked = token != nullptr || deadline != clock::time_point::max();
+  std::int64_t band_rows =
+      std::max<std::int64_t>(1, kCellsPerCheck / this->width_);
+  std::vector<std::uint8_t> column_sums(this->width_);
 
-  if (Alive(index)) {
-    if (num_live_neighbors == 2 || num_live_neighbors == 3) {
-      return true;
-    } else {
+  for (std::int64_t row = 0; row < this->height_; row += band_rows) {
+    if (checked && (clock::now() >= deadline ||
+                    (token != nullptr && token->IsCancelled()))) {
       return false;
     }
-  } else {
-    if (num_live_neighbors == 3) {
-      return true;
-    } else {
-      return false;
+    std::int64_t band_end = std::min(this->height_, row + band_rows);
+    for (std::int64_t r = row; r < band_end; ++r) {
+      StepRow(r, column_sums, next.data() + ConvertTo1D(r, 0));
     }
   }
+  return true;
 }
 
-int GameOfLife::CalcNumLiveNeighbors(size_t index) {
-  std::array<size_t, 8> neighbor_indices = GetNeighborIndices(index);
-  return NumAlive(neighbor_indices);
+void GameOfLife::BuildAliveTable() const {
+  std::lock_guard<std::mutex> lock(this->alive_table_.mutex);
+  if (this->alive_table_.valid) {
+    return;
+  }
+  std::vector<std::uint32_t> &table = this->alive_table_.table;
+  std::int64_t stride = this->width_ + 1;
+  table.assign(stride * (this->height_ + 1), 0);
+  for (std::int64_t row = 0; row < this->height_; ++row) {
+    std::uint32_t row_total = 0;
+    for (std::int64_t col = 0; col < this->width_; ++col) {
+      row_total += Alive(ConvertTo1D(row, col)) ? 1 : 0;
+      table[(row + 1) * stride + col + 1] =
+          table[row * stride + col + 1] + row_total;
+    }
+  }
+  this->alive_table_.valid = true;
 }
 
-std::array<size_t, 8> GameOfLife::GetNeighborIndices(size_t index) {
-  std::array<size_t, 8> neighbor_indices;
-  std::pair<int, int> row_col = ConvertTo2D(index);
-  int row = row_col.first;
-  int col = row_col.second;
+std::int64_t GameOfLife::CountAliveInBounds(std::int64_t row,
+                                            std::int64_t col,
+                                            std::int64_t rows,
+                                            std::int64_t cols) const {
+  if (rows == 0 || cols == 0) {
+    return 0;
+  }
+  if (rows * cols > std::numeric_limits<std::uint32_t>::max()) {
+    // Too many cells for the modular table entries to give an exact count
+    std::int64_t total = 0;
+    for (std::int64_t r = row; r < row + rows; ++r) {
+      auto row_begin = this->current_.begin() + ConvertTo1D(r, col);
+      total += std::count(row_begin, row_begin + cols, '*');
+    }
+    return total;
+  }
+  const std::vector<std::uint32_t> &table = this->alive_table_.table;
+  std::int64_t stride = this->width_ + 1;
+  std::int64_t bottom = row + rows;
+  std::int64_t right = col + cols;
+  // Unsigned wrap around cancels out, leaving the exact count
+  std::uint32_t count = table[bottom * stride + right] -
+                        table[row * stride + right] -
+                        table[bottom * stride + col] +
+                        table[row * stride + col];
+  return count;
+}
 
-  neighbor_indices[0] = ConvertTo1D(DecrementRow(row), col); // up
-  neighbor_indices[1] =
-      ConvertTo1D(DecrementRow(row), DecrementCol(col)); // up left
-  neighbor_indices[2] =
-      ConvertTo1D(DecrementRow(row), IncrementCol(col)); // up right
+std::uint64_t GameOfLife::CellKey(size_t index) {
+  // splitmix64 finalizer: a cheap, well-mixed key for every cell index
+  std::uint64_t key = static_cast<std::uint64_t>(index) + 0x9e3779b97f4a7c15;
+  key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9;
+  key = (key ^ (key >> 27)) * 0x94d049bb133111eb;
+  return key ^ (key >> 31);
+}
 
-  neighbor_indices[3] = ConvertTo1D(row, DecrementCol(col)); // left
-  neighbor_indices[4] = ConvertTo1D(row, IncrementCol(col)); // right
+std::uint64_t GameOfLife::SegmentHash(size_t index, size_t len) const {
+  std::uint64_t hash = 0;
+  for (size_t i = index; i < index + len; ++i) {
+    if (Alive(i)) {
+      hash ^= CellKey(i);
+    }
+  }
+  return hash;
+}
 
-  neighbor_indices[5] = ConvertTo1D(IncrementRow(row), col); // down
-  neighbor_indices[6] =
-      ConvertTo1D(IncrementRow(row), DecrementCol(col)); // down left
-  neighbor_indices[7] =
-      ConvertTo1D(IncrementRow(row), IncrementCol(col)); // down right
+void GameOfLife::CheckCells(std::span<const cell_coord> cells,
+                            const std::string &function) const {
+  for (const cell_coord &cell : cells) {
+    if (cell.first < 0 || cell.first >= this->height_ || cell.second < 0 ||
+        cell.second >= this->width_) {
+      throw range_error("\nError\nFile: game_of_life.cpp \nFunction: " +
+                        function + "\nThe cell at " + to_string(cell.first) +
+                        "," + to_string(cell.second) +
+                        " is out of bounds. No cells were changed.");
+    }
+  }
+}
 
-  return neighbor_indices;
+void GameOfLife::CheckRegion(std::int64_t row, std::int64_t col,
+                             std::int64_t rows, std::int64_t cols,
+                             const std::string &function) const {
+  if (row < 0 || row >= this->height_ || col < 0 || col >= this->width_) {
+    throw range_error("\nError\nFile: game_of_life.cpp \nFunction: " +
+                      function + "\nThe origin " + to_string(row) + "," +
+                      to_string(col) + " is out of bounds.");
+  }
+  if (rows < 0 || rows > this->height_ || cols < 0 || cols > this->width_) {
+    throw range_error("\nError\nFile: game_of_life.cpp \nFunction: " +
+                      function + "\nA " + to_string(rows) + "x" +
+                      to_string(cols) + " region does not fit on the board.");
+  }
 }
 
-int GameOfLife::NumAlive(std::array<size_t, 8> cell_indices) {
-  int total_alive = 0;
-  for (const int index : cell_indices) {
-    if (Alive(index)) {
-      total_alive++;
-    }
+void GameOfLife::BlitRow(std::int64_t row, std::int64_t col, const char *src,
+                         std::int64_t len, paste_mode mode) {
+  // Split the row into the part before the right edge and the wrapped part
+  std::int64_t first_len = std::min(len, this->width_ - col);
+  BlitSegment(ConvertTo1D(row, col), src, first_len, mode);
+  if (first_len < len) {
+    BlitSegment(ConvertTo1D(row, 0), src + first_len, len - first_len, mode);
   }
-  return total_alive;
 }
 
-bool GameOfLife::Alive(size_t index) const {
-  return this->current_[index] == '*';
+void GameOfLife::BlitSegment(size_t index, const char *src, std::int64_t len,
+                             paste_mode mode) {
+  // Overwriting is a plain copy. The other modes are a branch-free per-cell
+  // select over two contiguous ranges, which the compiler vectorizes at -O3
+  char *dest = this->current_.data() + index;
+  switch (mode) {
+  case paste_mode::kOverwrite:
+    std::memcpy(dest, src, len);
+    break;
+  case paste_mode::kOr:
+    std::transform(src, src + len, dest, dest, [](char from, char to) {
+      return (from == '*' || to == '*') ? '*' : '-';
+    });
+    break;
+  case paste_mode::kXor:
+    std::transform(src, src + len, dest, dest, [](char from, char to) {
+      return ((from == '*') != (to == '*')) ? '*' : '-';
+    });
+    break;
+  case paste_mode::kAnd:
+    std::transform(src, src + len, dest, dest, [](char from, char to) {
+      return (from == '*' && to == '*') ? '*' : '-';
+    });
+    break;
+  case paste_mode::kAndNot:
+    std::transform(src, src + len, dest, dest, [](char from, char to) {
+      return (from != '*' && to == '*') ? '*' : '-';
+    });
+    break;
+  }
 }
 
-size_t GameOfLife::ConvertTo1D(int row, int col) {
-  return (row * this->width_) + col;
+GameOfLife &GameOfLife::Combine(const GameOfLife &other, paste_mode mode,
+                                const std::string &function) {
+  if (this->width_ != other.width_ || this->height_ != other.height_) {
+    throw range_error("\nError\nFile: game_of_life.cpp \nFunction: " +
+                      function + "\nA " + to_string(other.height_) + "x" +
+                      to_string(other.width_) +
+                      " board cannot be combined with a " +
+                      to_string(this->height_) + "x" +
+                      to_string(this->width_) + " board.");
+  }
+  // Both boards are stored row by row, so they combine as one long segment
+  BlitSegment(0, other.current_.data(), other.current_.size(), mode);
+  BoardChanged();
+  return *this;
 }
 
-std::pair<size_t, size_t> GameOfLife::ConvertTo2D(size_t index) {
-  size_t row = index / this->width_;
-  size_t col = index % this->width_;
+std::vector<std::string>
+GameOfLife::OrientedRows(pattern_orientation orientation) const {
+  std::int64_t h = this->height_;
+  std::int64_t w = this->width_;
+  bool transposed = orientation == kRotate90 || orientation == kRotate270 ||
+                    orientation == kFlipDiagonal ||
+                    orientation == kFlipAntiDiagonal;
+  std::int64_t rows = transposed ? w : h;
+  std::int64_t cols = transposed ? h : w;
+  std::vector<std::string> oriented(rows, std::string(cols, '-'));
 
-  return {row, col};
+  for (std::int64_t r = 0; r < rows; ++r) {
+    for (std::int64_t c = 0; c < cols; ++c) {
+      // Find the cell of the original board that lands on r,c
+      std::int64_t from_row = r, from_col = c;
+      switch (orientation) {
+      case kRotate90:
+        from_row = h - 1 - c, from_col = r;
+        break;
+      case kRotate180:
+        from_row = h - 1 - r, from_col = w - 1 - c;
+        break;
+      case kRotate270:
+        from_row = c, from_col = w - 1 - r;
+        break;
+      case kFlipHorizontal:
+        from_col = w - 1 - c;
+        break;
+      case kFlipVertical:
+        from_row = h - 1 - r;
+        break;
+      case kFlipDiagonal:
+        from_row = c, from_col = r;
+        break;
+      case kFlipAntiDiagonal:
+        from_row = h - 1 - c, from_col = w - 1 - r;
+        break;
+      default:
+        break;
+      }
+      oriented[r][c] = this->current_[ConvertTo1D(from_row, from_col)];
+    }
+  }
+  return oriented;
 }
 
-int GameOfLife::IncrementCol(int col) { return (col + 1) % this->width_; }
+bool GameOfLife::MatchesAt(const std::vector<std::string> &rows,
+                           std::int64_t row, std::int64_t col) const {
+  std::int64_t len = rows[0].size();
+  // Each row is compared as at most two contiguous runs, split at the edge
+  std::int64_t first_len = std::min(len, this->width_ - col);
+  for (const std::string &pattern_row : rows) {
+    const char *board_row = this->current_.data() + ConvertTo1D(row, 0);
+    if (std::memcmp(board_row + col, pattern_row.data(), first_len) != 0 ||
+        (first_len < len &&
+         std::memcmp(board_row, pattern_row.data() + first_len,
+                     len - first_len) != 0)) {
+      return false;
+    }
+    if (++row == this->height_) {
+      row = 0;
+    }
+  }
+  return true;
+}
 
-int GameOfLife::DecrementCol(int col) {
-  return ((col - 1) + this->width_) % this->width_;
+void GameOfLife::StepRow(std::int64_t row,
+                         std::vector<std::uint8_t> &column_sums, char *next) {
+  const char *up = this->current_.data() + ConvertTo1D(DecrementRow(row), 0);
+  const char *mid = this->current_.data() + ConvertTo1D(row, 0);
+  const char *down = this->current_.data() + ConvertTo1D(IncrementRow(row), 0);
+  std::int64_t width = this->width_;
+  // Index through a plain pointer: byte stores through the vector could
+  // alias its own data pointer and keep the loops from vectorizing
+  std::uint8_t *sums = column_sums.data();
+  for (std::int64_t col = 0; col < width; ++col) {
+    sums[col] = (up[col] == '*') + (mid[col] == '*') + (down[col] == '*');
+  }
+  // The neighborhood sum includes the cell itself. Bitwise operators keep
+  // the select free of branches
+  auto next_cell = [&](std::int64_t left, std::int64_t col,
+                       std::int64_t right) {
+    int total = sums[left] + sums[col] + sums[right];
+    bool alive = (total == 3) | ((total == 4) & (mid[col] == '*'));
+    return alive ? '*' : '-';
+  };
+  next[0] = next_cell(width - 1, 0, 1 % width);
+  for (std::int64_t col = 1; col < width - 1; ++col) {
+    next[col] = next_cell(col - 1, col, col + 1);
+  }
+  if (width > 1) {
+    next[width - 1] = next_cell(width - 2, width - 1, 0);
+  }
 }
 
-int GameOfLife::IncrementRow(int row) { return (row + 1) % this->height_; }
+bool GameOfLife::Alive(size_t index) const {
+  return this->current_[index] == '*';
+}
+
+size_t GameOfLife::ConvertTo1D(std::int64_t row, std::int64_t col) const {
+  return (row * this->width_) + col;
+}
+
+std::int64_t GameOfLife::IncrementRow(std::int64_t row) {
+  return (row + 1) % this->height_;
+}
 
-int GameOfLife::DecrementRow(int row) {
+std::int64_t GameOfLife::DecrementRow(std::int64_t row) {
   return ((row - 1) + this->height_) % this->height_;
 }
 
 std::ostream &GOL::operator<<(ostream &os, const GameOfLife &game) {
   os << "Generation: " << game.GetGenerations() << '\n';
-  int curr_col = 1;
+  std::int64_t curr_col = 1;
 
   for (char cell : game.current_) {
     if (cell == '*')
@@ -1,10 +1,105 @@
 #ifndef GameOfLife_H_DEFINED
 #define GameOfLife_H_DEFINED
-#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <mutex>
+#include <span>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace GOL {
+/**
+ * cell_coord, a (row, col) coordinate pair on the game board
+ */
+using cell_coord = std::pair<std::int64_t, std::int64_t>;
+
+/**
+ * enum class paste_mode
+ *
+ * Determines how the cells of a pasted board are combined with the cells
+ * already on the destination board
+ */
+enum class paste_mode {
+  kOverwrite, // destination cells take the value of the pasted cells
+  kOr,        // destination cells are alive if either cell is alive
+  kXor,       // destination cells are toggled wherever the pasted cell is alive
+  kAnd,       // destination cells stay alive only where the pasted cell is alive
+  kAndNot     // destination cells are cleared wherever the pasted cell is alive
+};
+
+/**
+ * enum pattern_orientation
+ *
+ * The eight rotations and reflections of a pattern searched for by
+ * FindPattern. Values are bit flags and may be combined with '|'
+ */
+enum pattern_orientation : unsigned {
+  kIdentity = 1,           // the pattern as given
+  kRotate90 = 2,           // rotated a quarter turn clockwise
+  kRotate180 = 4,          // rotated a half turn
+  kRotate270 = 8,          // rotated a quarter turn counter-clockwise
+  kFlipHorizontal = 16,    // mirrored left to right
+  kFlipVertical = 32,      // mirrored top to bottom
+  kFlipDiagonal = 64,      // mirrored across the main diagonal (transposed)
+  kFlipAntiDiagonal = 128, // mirrored across the anti-diagonal
+  kAllOrientations = 255
+};
+
+/**
+ * struct pattern_match
+ *
+ * This struct stores one place where FindPattern found a pattern.
+ */
+struct pattern_match {
+  /**
+   * int64_t row, the row of the top left corner of the oriented pattern
+   */
+  std::int64_t row;
+
+  /**
+   * int64_t col, the column of the top left corner of the oriented pattern
+   */
+  std::int64_t col;
+
+  /**
+   * pattern_orientation orientation, the orientation that matched. When
+   * several orientations of a symmetric pattern are identical, only the first
+   * requested one is reported
+   */
+  pattern_orientation orientation;
+};
+
+/**
+ * class CancellationToken
+ *
+ * A flag that one thread sets to ask long-running GameOfLife calls on another
+ * thread to stop early. Cancel and IsCancelled are safe to call concurrently.
+ */
+class CancellationToken {
+  /**
+   * std::atomic<bool> cancelled_, true once Cancel has been called
+   */
+  std::atomic<bool> cancelled_{false};
+
+public:
+  /**
+   * void Cancel()
+   * Requests that every call watching this token stops
+   */
+  void Cancel() { this->cancelled_.store(true, std::memory_order_relaxed); }
+
+  /**
+   * bool IsCancelled()
+   * Returns true once Cancel has been called
+   */
+  bool IsCancelled() const {
+    return this->cancelled_.load(std::memory_order_relaxed);
+  }
+};
+
 /**
  * struct game_save_state
  *
@@ -77,16 +172,16 @@ class GameOfLife {
   char dead_cell_;
 
   /**
-   * int width_, this integer stores the value for the width
+   * int64_t width_, this integer stores the value for the width
    * of the game table
    */
-  int width_;
+  std::int64_t width_;
 
   /**
-   * int height_, this integer stores the value for the height of the
+   * int64_t height_, this integer stores the value for the height of the
    * game table
    */
-  int height_;
+  std::int64_t height_;
 
   /**
    * std::string current_, this string stores the current status (dead or
@@ -113,6 +208,93 @@ class GameOfLife {
    */
   game_save_state previous_generations_[100];
 
+  /**
+   * struct alive_table_cache
+   *
+   * A summed-area table of live cells. Entry (r, c) of this
+   * (height_ + 1) x (width_ + 1) table holds the number of live cells above
+   * and to the left of cell r,c, modulo 2^32. Differences of entries are
+   * still exact for any window of fewer than 2^32 cells.
+   *
+   * Rebuilt lazily by CountAlive. The rebuild is guarded by mutex so that
+   * several threads may query the same unchanging board. Copying a board does
+   * not copy the table: the copy starts with an empty, invalid cache and
+   * builds its own only if CountAlive is called on it
+   */
+  struct alive_table_cache {
+    std::vector<std::uint32_t> table;
+    std::atomic<bool> valid{false};
+    mutable std::mutex mutex;
+
+    alive_table_cache() = default;
+    alive_table_cache(const alive_table_cache &) {}
+    alive_table_cache &operator=(const alive_table_cache &other) {
+      if (this != &other) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->table.clear();
+        this->table.shrink_to_fit();
+        this->valid = false;
+      }
+      return *this;
+    }
+  };
+
+  /**
+   * alive_table_cache alive_table_, the summed-area table used by CountAlive
+   */
+  mutable alive_table_cache alive_table_;
+
+  /**
+   * struct hash_cache
+   *
+   * The XOR of CellKey(index) over every live cell. Changes to the board only
+   * mark it stale, so stepping and editing never pay for hashing; Hash()
+   * recomputes it on first use. The recompute is guarded by mutex so that
+   * several threads may hash the same unchanging board. Copies keep the value
+   * and get their own mutex
+   */
+  struct hash_cache {
+    std::uint64_t value = 0;
+    std::atomic<bool> valid{false};
+    mutable std::mutex mutex;
+
+    hash_cache() = default;
+    hash_cache(const hash_cache &other) { *this = other; }
+    hash_cache &operator=(const hash_cache &other) {
+      if (this != &other) {
+        std::lock_guard<std::mutex> lock(other.mutex);
+        this->value = other.value;
+        this->valid = other.valid.load();
+      }
+      return *this;
+    }
+  };
+
+  /**
+   * hash_cache hash_, the cell hash behind Hash()
+   */
+  mutable hash_cache hash_;
+
+  /**
+   * struct scratch_board
+   *
+   * The buffer each next generation is written into before it is swapped
+   * with current_. Keeping it saves allocating a whole new board every
+   * generation. Copies start with an empty buffer of their own
+   */
+  struct scratch_board {
+    std::string cells;
+
+    scratch_board() = default;
+    scratch_board(const scratch_board &) {}
+    scratch_board &operator=(const scratch_board &) { return *this; }
+  };
+
+  /**
+   * scratch_board next_, the board the next generation is calculated into
+   */
+  scratch_board next_;
+
 public:
   /**
    * No default constructor
@@ -189,6 +371,18 @@ public:
   GameOfLife(std::string filename, char live_cell, char dead_cell,
              int generationCount);
 
+  /**
+   * GameOfLife(int64_t width, int64_t height)
+   * Blank constructor, construct a GameOfLife object gameboard of the given
+   * dimensions where every cell is dead
+   *
+   * @throws Runtime Error if width or height is not positive
+   *
+   * @param width The number of columns in the game board
+   * @param height The number of rows in the game board
+   */
+  GameOfLife(std::int64_t width, std::int64_t height);
+
   /**
    * GetGenerations()
    * Retreives the number of generation calculations that the
@@ -203,6 +397,45 @@ public:
    */
   int GetAvailableGens() const { return this->rollback_limit_; }
 
+  /**
+   * GetWidth()
+   * Returns the number of columns in the game board
+   */
+  std::int64_t GetWidth() const { return this->width_; }
+
+  /**
+   * GetHeight()
+   * Returns the number of rows in the game board
+   */
+  std::int64_t GetHeight() const { return this->height_; }
+
+  /**
+   * GetLiveCell()
+   * Returns the character used to display live cells
+   */
+  char GetLiveCell() const { return this->live_cell_; }
+
+  /**
+   * GetDeadCell()
+   * Returns the character used to display dead cells
+   */
+  char GetDeadCell() const { return this->dead_cell_; }
+
+  /**
+   * bool IsAlive(int64_t row, int64_t col)
+   * Checks whether the cell at row,col is alive in the current generation
+   *
+   * @throws range error if either row or col is out of bounds
+   */
+  bool IsAlive(std::int64_t row, std::int64_t col) const;
+
+  /**
+   * std::vector<cell_coord> LiveCells()
+   * Returns the row,col coordinates of every live cell in the current
+   * generation, in row major order
+   */
+  std::vector<cell_coord> LiveCells() const;
+
   /**
    * SetLiveCell(char live_cell)
    * Changes the character for the Live Cell
@@ -320,6 +553,116 @@ public:
    */
   GameOfLife operator-();
 
+  /**
+   * GameOfLife operator&(const GameOfLife &other)
+   * Intersection. Returns a copy of the game where only cells alive on both
+   * boards are alive
+   *
+   * @throws range error if the boards have different dimensions
+   */
+  GameOfLife operator&(const GameOfLife &other) const;
+
+  /**
+   * GameOfLife operator|(const GameOfLife &other)
+   * Union. Returns a copy of the game where cells alive on either board are
+   * alive
+   *
+   * @throws range error if the boards have different dimensions
+   */
+  GameOfLife operator|(const GameOfLife &other) const;
+
+  /**
+   * GameOfLife operator^(const GameOfLife &other)
+   * Symmetric difference. Returns a copy of the game where cells alive on
+   * exactly one of the boards are alive
+   *
+   * @throws range error if the boards have different dimensions
+   */
+  GameOfLife operator^(const GameOfLife &other) const;
+
+  /**
+   * GameOfLife AndNot(const GameOfLife &other)
+   * Difference. Returns a copy of the game where cells alive on other are
+   * dead
+   *
+   * @throws range error if the boards have different dimensions
+   */
+  GameOfLife AndNot(const GameOfLife &other) const;
+
+  /**
+   * operator&=(const GameOfLife &other)
+   * In-place intersection. Only the board changes; generations, history and
+   * cell characters are untouched
+   *
+   * @throws range error if the boards have different dimensions
+   */
+  GameOfLife &operator&=(const GameOfLife &other);
+
+  /**
+   * operator|=(const GameOfLife &other)
+   * In-place union. Only the board changes
+   *
+   * @throws range error if the boards have different dimensions
+   */
+  GameOfLife &operator|=(const GameOfLife &other);
+
+  /**
+   * operator^=(const GameOfLife &other)
+   * In-place symmetric difference. Only the board changes
+   *
+   * @throws range error if the boards have different dimensions
+   */
+  GameOfLife &operator^=(const GameOfLife &other);
+
+  /**
+   * AndNotAssign(const GameOfLife &other)
+   * In-place difference. Kills every cell that is alive on other
+   *
+   * @throws range error if the boards have different dimensions
+   */
+  GameOfLife &AndNotAssign(const GameOfLife &other);
+
+  /**
+   * void Translate(int64_t rows, int64_t cols)
+   * Shifts every cell down by rows and right by cols in place, wrapping around
+   * the board edges. Negative values shift up or left
+   */
+  void Translate(std::int64_t rows, std::int64_t cols);
+
+  /**
+   * std::vector<pattern_match> FindPattern(const GameOfLife &pattern,
+   * unsigned orientations)
+   * Finds every position where the board of pattern, in any of the requested
+   * orientations, appears on this board with wrap around. Every cell of the
+   * pattern board must match, dead cells included. Matches are returned
+   * sorted by row, then column
+   *
+   * Only positions where a live board cell lines up with the first live cell
+   * of an orientation are checked, so the cost is one pass over the board
+   * plus a few word compares per live cell. Mostly dead boards are searched at
+   * about memory speed. A pattern with no live cells is checked everywhere
+   *
+   * @throws range error if an orientation of pattern is larger than the board
+   *
+   * @param pattern The board to search for
+   * @param orientations pattern_orientation flags to try
+   */
+  std::vector<pattern_match> FindPattern(const GameOfLife &pattern,
+                                         unsigned orientations) const;
+
+  /**
+   * std::vector<pattern_match> FindPattern(const GameOfLife &pattern,
+   * unsigned orientations, bool isolated)
+   * Same as FindPattern(pattern, orientations). When isolated is true, the
+   * one-cell ring around each match must also be dead
+   *
+   * @throws range error if an orientation of pattern, plus the ring when
+   * isolated, is larger than the board
+   */
+  std::vector<pattern_match> FindPattern(const GameOfLife &pattern,
+                                         unsigned orientations,
+                                         bool isolated) const;
+
   /**
    * operator==(const GameOfLife &)
    * The  "==" operator compares if the proportion of living cells in two
@@ -356,6 +699,33 @@ public:
    */
   bool operator>=(const GameOfLife &) const;
 
+  /**
+   * bool Equals(const GameOfLife &other)
+   * Exact comparison. Returns true if both game boards have the same
+   * dimensions and every cell has the same live/dead state. Cell characters,
+   * generation counts and history are ignored. When both boards already have
+   * an up to date hash, differing hashes end the comparison early; otherwise
+   * the cells are compared directly, which is cheaper than hashing them
+   */
+  bool Equals(const GameOfLife &other) const;
+
+  /**
+   * uint64_t Hash()
+   * Returns a 64-bit hash of the board dimensions and cell states. Boards for
+   * which Equals is true always have the same hash. The first call after the
+   * board changes rehashes every cell; later calls are constant time
+   */
+  std::uint64_t Hash() const;
+
+  /**
+   * uint64_t VerifyHash()
+   * Returns a second 64-bit hash of the board dimensions and cell states,
+   * built from keys unrelated to those of Hash(). Keeping both hashes of a
+   * board confirms a later match without keeping the board itself. Not
+   * cached, so every call scans the board
+   */
+  std::uint64_t VerifyHash() const;
+
   /**
    * CalcPercentLiving()
    * Calculate and return the percentage of cells in the game board that are
@@ -372,29 +742,108 @@ public:
   bool IsStillLife() const;
 
   /**
-   * void ToggleCell(int index)
+   * int64_t CountAlive(int64_t row, int64_t col, int64_t rows, int64_t cols)
+   * Counts the live cells in the rows x cols window whose top left corner is
+   * row,col. The window wraps around the board edges. The first query after
+   * the board changes rebuilds a summed-area table in one pass; later queries
+   * on the same generation are answered in constant time
+   *
+   * @throws range error if row,col is out of bounds or the window is larger
+   * than the board
+   */
+  std::int64_t CountAlive(std::int64_t row, std::int64_t col,
+                          std::int64_t rows, std::int64_t cols) const;
+
+  /**
+   * void ToggleCell(int64_t index)
    * This method sets a live cell at index to a dead cell and vice-versa
    * 
    * @throws range error if index is out of bounds
    */
-  void ToggleCell(int index);
+  void ToggleCell(std::int64_t index);
 
   /**
-   * void ToggleCell(int row, int col)
+   * void ToggleCell(int64_t row, int64_t col)
    * This method sets a live cell at row,col to dead and vice-versa
    * 
    * @throws range error if either row or col is out of bounds
    */
-  void ToggleCell(int row, int col);
+  void ToggleCell(std::int64_t row, std::int64_t col);
+
+  /**
+   * void SetCells(std::span<const cell_coord> cells)
+   * Sets every cell at the given row,col coordinates to alive. The whole batch
+   * is validated before any cell is changed
+   *
+   * @throws range error if any coordinate is out of bounds
+   */
+  void SetCells(std::span<const cell_coord> cells);
+
+  /**
+   * void ClearCells(std::span<const cell_coord> cells)
+   * Sets every cell at the given row,col coordinates to dead. The whole batch
+   * is validated before any cell is changed
+   *
+   * @throws range error if any coordinate is out of bounds
+   */
+  void ClearCells(std::span<const cell_coord> cells);
+
+  /**
+   * void ToggleCells(std::span<const cell_coord> cells)
+   * Toggles every cell at the given row,col coordinates. A coordinate listed
+   * twice is toggled twice. The whole batch is validated before any cell is
+   * changed
+   *
+   * @throws range error if any coordinate is out of bounds
+   */
+  void ToggleCells(std::span<const cell_coord> cells);
+
+  /**
+   * void FillRect(int64_t row, int64_t col, int64_t rows, int64_t cols,
+   * bool alive)
+   * Sets every cell in the rows x cols rectangle whose top left corner is
+   * row,col to alive (or dead). The rectangle wraps around the board edges
+   *
+   * @throws range error if row,col is out of bounds or the rectangle is larger
+   * than the board
+   */
+  void FillRect(std::int64_t row, std::int64_t col, std::int64_t rows,
+                std::int64_t cols, bool alive);
+
+  /**
+   * void Paste(const GameOfLife &pattern, int64_t row, int64_t col,
+   * paste_mode mode)
+   * Stamps the game board of pattern onto this board with its top left corner
+   * at row,col, wrapping around the board edges. Cells are combined according
+   * to mode. Only the board is copied; generations and history are untouched.
+   * pattern may be this board, in which case the board as it was before the
+   * call is pasted
+   *
+   * @throws range error if row,col is out of bounds or pattern is larger than
+   * this board
+   */
+  void Paste(const GameOfLife &pattern, std::int64_t row, std::int64_t col,
+             paste_mode mode);
 
   /**
    * NextNGen()
    * @brief Calculates the next N generations of the current GameOfLife object
    * and sets this to be the new state of the object. Utilizes wrap around to
    * guarantee each cell has 8 neighbors. n times
+   *
+   * Only the last 100 of the n generations are saved for rollback; the ones
+   * before them are calculated without copying the board into the history
    */
   void NextNGen(int n);
 
+  /**
+   * NextNGenWithoutHistory(int n)
+   * @brief Calculates the next n generations like NextNGen, but saves none
+   * of them for rollback. The existing history no longer leads back to the
+   * current board, so it is discarded and GetAvailableGens() becomes 0
+   */
+  void NextNGenWithoutHistory(int n);
+
   /**
    * NextGen()
    * @brief Calculates next generation of the GameOfLife object and sets this to
@@ -407,97 +856,236 @@ public:
    */
   void NextGen();
 
-private:
   /**
-   * AliveNextGen(size_t index)
-   * Determines whether the specified index in the game board string will be
-   * alive in the next generation
+   * int StepFor(std::chrono::steady_clock::duration budget)
+   * Calculates as many whole generations as fit in budget, saving each one
+   * for rollback like NextGen. A generation is not started if the previous
+   * one suggests it would finish after the budget runs out. The clock is also
+   * checked every few row bands while a generation is calculated; a
+   * generation still unfinished at the deadline is dropped, leaving the board
+   * at the last whole generation, so the call returns shortly after the
+   * budget runs out even on very large boards
+   *
+   * @return the number of generations calculated
+   */
+  int StepFor(std::chrono::steady_clock::duration budget);
+
+  /**
+   * int StepFor(std::chrono::steady_clock::duration budget,
+   * const CancellationToken &token)
+   * Same as StepFor(budget), but also stops once token is cancelled. The
+   * token is checked as often as the clock, and a generation interrupted by
+   * the cancel is dropped
    *
-   * @return bool, true if index will be alive next generation,
-   * otherwise false
+   * @return the number of generations calculated
    */
-  bool AliveNextGen(size_t index);
+  int StepFor(std::chrono::steady_clock::duration budget,
+              const CancellationToken &token);
 
   /**
-   * CalcNumLiveNeighbors(size_t index)
-   * Determines how many neighbors the cell at the given index has that
-   * are alive in the current generation
+   * int StepUntil(std::chrono::steady_clock::time_point deadline,
+   * int max_gens)
+   * Calculates up to max_gens whole generations, stopping early if the next
+   * generation would not finish by deadline. As with StepFor, a generation
+   * still unfinished at the deadline is dropped
    *
-   * @return int, the number of live neighbors
+   * @return the number of generations calculated
    */
-  int CalcNumLiveNeighbors(size_t index);
+  int StepUntil(std::chrono::steady_clock::time_point deadline, int max_gens);
 
   /**
-   * GetNeighborIndices(size_t index)
-   * Finds the indices in _current string that are
-   * neighbors to the cell specified by index
+   * int StepUntil(std::chrono::steady_clock::time_point deadline,
+   * int max_gens, const CancellationToken &token)
+   * Same as StepUntil(deadline, max_gens), but also stops once token is
+   * cancelled, dropping any generation the cancel interrupts
    *
-   * @return std::array<int,8> an array of the index for each
-   * of a given cell's 8 neighbors
+   * @return the number of generations calculated
    */
-  std::array<size_t, 8> GetNeighborIndices(size_t index);
+  int StepUntil(std::chrono::steady_clock::time_point deadline, int max_gens,
+                const CancellationToken &token);
+
+private:
+  /**
+   * StepWithin(std::chrono::steady_clock::time_point deadline, int max_gens,
+   * const CancellationToken *token)
+   * Shared implementation of StepFor and StepUntil. token may be null
+   */
+  int StepWithin(std::chrono::steady_clock::time_point deadline, int max_gens,
+                 const CancellationToken *token);
 
   /**
-   * NumAlive(std::array<size_t, 8> cell_indices)
-   * Given an array of indices, determine how many of the cells at those indices
-   * in the game board are alive
+   * DeadlineAfter(std::chrono::steady_clock::duration budget)
+   * Returns the time point budget from now, clamped to
+   * steady_clock::time_point::max() when the sum would overflow
+   */
+  static std::chrono::steady_clock::time_point
+  DeadlineAfter(std::chrono::steady_clock::duration budget);
+
+  /**
+   * StepBoard()
+   * Calculates the next generation and advances the generation count without
+   * saving the current board to previous_generations_ or changing
+   * rollback_limit_
+   */
+  void StepBoard();
+
+  /**
+   * SaveGeneration()
+   * Saves the current board to previous_generations_ so that it can be rolled
+   * back to once the board advances
+   */
+  void SaveGeneration();
+
+  /**
+   * CalcNextBoard(std::string &next,
+   * std::chrono::steady_clock::time_point deadline,
+   * const CancellationToken *token)
+   * Writes the next generation of the board into next, one band of rows at a
+   * time. Before each band the clock and token (which may be null) are
+   * checked, and the calculation is abandoned if the deadline has passed or
+   * the token is cancelled. The board itself is never modified
    *
-   * @param cell_indices: an array of index values in the current_ string
+   * @return true if next holds the whole next generation
+   */
+  bool CalcNextBoard(std::string &next,
+                     std::chrono::steady_clock::time_point deadline,
+                     const CancellationToken *token);
+
+  /**
+   * BoardChanged()
+   * Marks every cached view of the board (alive_table_ and hash_) as stale.
+   * Must be called whenever current_ is modified
+   */
+  void BoardChanged() {
+    this->alive_table_.valid = false;
+    this->hash_.valid = false;
+  }
+
+  /**
+   * BuildAliveTable()
+   * Rebuilds alive_table_ from the current game board unless another thread
+   * already has
+   */
+  void BuildAliveTable() const;
+
+  /**
+   * CellKey(size_t index)
+   * Returns the pseudo-random 64-bit key XORed into hash_ for each live cell
+   * at index
+   */
+  static std::uint64_t CellKey(size_t index);
+
+  /**
+   * SegmentHash(size_t index, size_t len)
+   * Returns the XOR of CellKey over the live cells among the len cells
+   * starting at index
+   */
+  std::uint64_t SegmentHash(size_t index, size_t len) const;
+
+  /**
+   * CountAliveInBounds(int64_t row, int64_t col, int64_t rows, int64_t cols)
+   * Counts the live cells in a window that does not wrap, using alive_table_.
+   * Windows of 2^32 cells or more are counted directly
+   */
+  std::int64_t CountAliveInBounds(std::int64_t row, std::int64_t col,
+                                  std::int64_t rows, std::int64_t cols) const;
+
+  /**
+   * CheckCells(std::span<const cell_coord> cells, const std::string &function)
+   * Validates that every coordinate in cells lies on the game board
    *
-   * @return int value representing the number of cells represented in
-   * cell_indices that are alive (* character)
+   * @throws range error naming function if any coordinate is out of bounds
    */
-  int NumAlive(std::array<size_t, 8> cell_indices);
+  void CheckCells(std::span<const cell_coord> cells,
+                  const std::string &function) const;
 
   /**
-   * Alive(size_t index)
-   * Determines if the cell at the specified index is alive
-   * in current generation in the gameboard
+   * CheckRegion(int64_t row, int64_t col, int64_t rows, int64_t cols,
+   * const std::string &function)
+   * Validates that row,col lies on the game board and that a rows x cols
+   * region fits on the board once wrapped
    *
-   * @return boolean: true if cell is alive, otherwise false
+   * @throws range error naming function if the region is invalid
    */
-  bool Alive(size_t index) const;
+  void CheckRegion(std::int64_t row, std::int64_t col, std::int64_t rows,
+                   std::int64_t cols, const std::string &function) const;
 
   /**
-   * ConvertTo1d(int row, int col))
-   * Converts a row,col coordinate pair into the proper location in
-   * a one-dimensional representation of the matrix
+   * BlitRow(int64_t row, int64_t col, const char *src, int64_t len,
+   * paste_mode mode)
+   * Combines len cells from src into the given row starting at col, wrapping
+   * past the last column back to column 0
    */
-  size_t ConvertTo1D(int row, int col);
+  void BlitRow(std::int64_t row, std::int64_t col, const char *src,
+               std::int64_t len, paste_mode mode);
 
   /**
-   * ConvertTo2D(size_t index)
-   * Converts an index in a 1 dimensional representation of the
-   * matrix into the correct row,col coordinate in the matrix
+   * BlitSegment(size_t index, const char *src, int64_t len, paste_mode mode)
+   * Combines len contiguous cells from src into current_ starting at index
    */
-  std::pair<size_t, size_t> ConvertTo2D(size_t index);
+  void BlitSegment(size_t index, const char *src, std::int64_t len,
+                   paste_mode mode);
 
   /**
-   * IncrementCol(int col)
-   * Finds the index of the column directly after the current
-   * column, wrapping around the matrix if necessary
+   * Combine(const GameOfLife &other, paste_mode mode,
+   * const std::string &function)
+   * Combines the whole board of other into this board in a single pass
    *
-   * @param col current column index
+   * @throws range error naming function if the boards have different
+   * dimensions
+   */
+  GameOfLife &Combine(const GameOfLife &other, paste_mode mode,
+                      const std::string &function);
+
+  /**
+   * OrientedRows(pattern_orientation orientation)
+   * Returns the rows of the board, as '*' and '-' strings, after applying a
+   * single orientation
+   */
+  std::vector<std::string> OrientedRows(pattern_orientation orientation) const;
+
+  /**
+   * MatchesAt(const std::vector<std::string> &rows, int64_t row, int64_t col)
+   * Checks whether rows appear on the board with their top left corner at
+   * row,col, wrapping around the board edges
    */
-  int IncrementCol(int col);
+  bool MatchesAt(const std::vector<std::string> &rows, std::int64_t row,
+                 std::int64_t col) const;
 
   /**
-   * DecrementCol(int col)
-   * Finds the index of the column directly preceding the current
-   * column, wrapping around the matrix if necessary
+   * StepRow(int64_t row, std::vector<std::uint8_t> &column_sums, char *next)
+   * Writes the next generation of the given row into next. column_sums is
+   * scratch space of width_ entries, reused from row to row. The wrapped
+   * first and last columns are handled on their own, so the columns between
+   * them are a branch-free loop the compiler can vectorize
+   */
+  void StepRow(std::int64_t row, std::vector<std::uint8_t> &column_sums,
+               char *next);
+
+  /**
+   * Alive(size_t index)
+   * Determines if the cell at the specified index is alive
+   * in current generation in the gameboard
    *
-   * @param col current column index
+   * @return boolean: true if cell is alive, otherwise false
+   */
+  bool Alive(size_t index) const;
+
+  /**
+   * ConvertTo1d(int64_t row, int64_t col))
+   * Converts a row,col coordinate pair into the proper location in
+   * a one-dimensional representation of the matrix
    */
-  int DecrementCol(int col);
+  size_t ConvertTo1D(std::int64_t row, std::int64_t col) const;
 
   /**
-   * IncrementRow(int row)
+   * IncrementRow(int64_t row)
    * Finds the index of the row directly after the current row,
    * wrapping around the matrix if necessary
    *
    * @param col current row index
    */
-  int IncrementRow(int row);
+  std::int64_t IncrementRow(std::int64_t row);
 
   /**
    * DecrementRow()
@@ -506,7 +1094,7 @@ private:
    *
    * @param col current column index
    */
-  int DecrementRow(int row);
+  std::int64_t DecrementRow(std::int64_t row);
 
   friend std::ostream &operator<<(std::ostream &os, const GameOfLife &game);
 };
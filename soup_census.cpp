@@ -0,0 +1,471 @@
+#include "soup_census.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using namespace GOL;
+//@author Trevor Chartier
+
+namespace {
+/**
+ * ObjectRows(std::vector<cell_coord> cells)
+ * Writes a group of cells as the rows of its bounding box, '*' for live
+ * cells and '.' for dead ones, separated by '/'
+ */
+string ObjectRows(vector<cell_coord> cells) {
+  std::int64_t min_row = cells[0].first, min_col = cells[0].second;
+  std::int64_t max_row = min_row, max_col = min_col;
+  for (const cell_coord &cell : cells) {
+    min_row = std::min(min_row, cell.first);
+    min_col = std::min(min_col, cell.second);
+    max_row = std::max(max_row, cell.first);
+    max_col = std::max(max_col, cell.second);
+  }
+  std::int64_t rows = max_row - min_row + 1;
+  std::int64_t cols = max_col - min_col + 1;
+  // Each row is followed by a '/' separator, the last one is dropped
+  string code(rows * (cols + 1), '.');
+  for (std::int64_t row = 0; row < rows; ++row) {
+    code[row * (cols + 1) + cols] = '/';
+  }
+  for (const cell_coord &cell : cells) {
+    code[(cell.first - min_row) * (cols + 1) + (cell.second - min_col)] = '*';
+  }
+  code.pop_back();
+  return code;
+}
+
+/**
+ * CanonicalRows(const std::vector<cell_coord> &cells)
+ * Returns the smallest ObjectRows string over the eight rotations and
+ * reflections of cells
+ */
+string CanonicalRows(const vector<cell_coord> &cells) {
+  string best;
+  vector<cell_coord> oriented(cells.size());
+  for (int orientation = 0; orientation < 8; ++orientation) {
+    for (size_t i = 0; i < cells.size(); ++i) {
+      std::int64_t row = cells[i].first, col = cells[i].second;
+      if (orientation & 4) {
+        std::swap(row, col);
+      }
+      oriented[i] = {(orientation & 1) ? -row : row,
+                     (orientation & 2) ? -col : col};
+    }
+    string code = ObjectRows(oriented);
+    if (best.empty() || code < best) {
+      best = code;
+    }
+  }
+  return best;
+}
+
+/**
+ * WrapCoord(int64_t value, int64_t size)
+ * Wraps an unbounded row or column back onto the board
+ */
+std::int64_t WrapCoord(std::int64_t value, std::int64_t size) {
+  return ((value % size) + size) % size;
+}
+
+/**
+ * int64_t kObjectReach, live cells this close to each other (in both rows
+ * and columns) are treated as one object, since they can affect each other
+ */
+constexpr std::int64_t kObjectReach = 2;
+
+/**
+ * int64_t kIsolationMargin, the number of empty rows and columns placed
+ * around an object when it is run on its own
+ */
+constexpr std::int64_t kIsolationMargin = 8;
+
+/**
+ * int kCheckpointInterval, how many generations apart the boards of a soup
+ * are recorded in the transposition table
+ */
+constexpr int kCheckpointInterval = 32;
+
+/**
+ * FindClusters(const GameOfLife &board)
+ * Splits the live cells of a board into objects. Cells are stored
+ * unwrapped, relative to the first cell found, so objects crossing an edge
+ * stay in one piece
+ */
+vector<vector<cell_coord>> FindClusters(const GameOfLife &board) {
+  std::int64_t width = board.GetWidth();
+  std::int64_t height = board.GetHeight();
+  // Cells are looked up many times each, so copy the board into a plain
+  // grid once instead of going through the bounds checked IsAlive
+  vector<char> alive(width * height, 0);
+  vector<cell_coord> live = board.LiveCells();
+  for (const cell_coord &cell : live) {
+    alive[cell.first * width + cell.second] = 1;
+  }
+  vector<char> visited(width * height, 0);
+  vector<vector<cell_coord>> clusters;
+
+  for (const auto &[row, col] : live) {
+    if (visited[row * width + col]) {
+      continue;
+    }
+    vector<cell_coord> cells;
+    vector<cell_coord> pending = {{row, col}};
+    visited[row * width + col] = 1;
+    while (!pending.empty()) {
+      cell_coord cell = pending.back();
+      pending.pop_back();
+      cells.push_back(cell);
+      for (std::int64_t d_row = -kObjectReach; d_row <= kObjectReach;
+           ++d_row) {
+        for (std::int64_t d_col = -kObjectReach; d_col <= kObjectReach;
+             ++d_col) {
+          std::int64_t n_row = cell.first + d_row;
+          std::int64_t n_col = cell.second + d_col;
+          std::int64_t w_row = WrapCoord(n_row, height);
+          std::int64_t w_col = WrapCoord(n_col, width);
+          if (!visited[w_row * width + w_col] &&
+              alive[w_row * width + w_col]) {
+            visited[w_row * width + w_col] = 1;
+            pending.emplace_back(n_row, n_col);
+          }
+        }
+      }
+    }
+    clusters.push_back(std::move(cells));
+  }
+  return clusters;
+}
+
+/**
+ * IsolatedBoard(const std::vector<cell_coord> &cells,
+ * const std::vector<cell_coord> &frame)
+ * Places cells on an empty board just large enough for the cells of frame
+ * plus kIsolationMargin on every side. cells must be a subset of frame
+ */
+GameOfLife IsolatedBoard(const vector<cell_coord> &cells,
+                         const vector<cell_coord> &frame) {
+  std::int64_t min_row = frame[0].first, min_col = frame[0].second;
+  std::int64_t max_row = min_row, max_col = min_col;
+  for (const cell_coord &cell : frame) {
+    min_row = std::min(min_row, cell.first);
+    min_col = std::min(min_col, cell.second);
+    max_row = std::max(max_row, cell.first);
+    max_col = std::max(max_col, cell.second);
+  }
+  vector<cell_coord> placed;
+  for (const cell_coord &cell : cells) {
+    placed.emplace_back(cell.first - min_row + kIsolationMargin,
+                        cell.second - min_col + kIsolationMargin);
+  }
+  GameOfLife isolated(max_col - min_col + 1 + 2 * kIsolationMargin,
+                      max_row - min_row + 1 + 2 * kIsolationMargin);
+  isolated.SetCells(placed);
+  return isolated;
+}
+
+/**
+ * SplitComponents(const std::vector<cell_coord> &cells)
+ * Splits unwrapped cells into 8-connected groups
+ */
+vector<vector<cell_coord>> SplitComponents(const vector<cell_coord> &cells) {
+  set<cell_coord> remaining(cells.begin(), cells.end());
+  vector<vector<cell_coord>> components;
+  while (!remaining.empty()) {
+    vector<cell_coord> component;
+    vector<cell_coord> pending = {*remaining.begin()};
+    remaining.erase(remaining.begin());
+    while (!pending.empty()) {
+      cell_coord cell = pending.back();
+      pending.pop_back();
+      component.push_back(cell);
+      for (std::int64_t d_row = -1; d_row <= 1; ++d_row) {
+        for (std::int64_t d_col = -1; d_col <= 1; ++d_col) {
+          auto found =
+              remaining.find({cell.first + d_row, cell.second + d_col});
+          if (found != remaining.end()) {
+            pending.push_back(*found);
+            remaining.erase(found);
+          }
+        }
+      }
+    }
+    components.push_back(std::move(component));
+  }
+  return components;
+}
+
+/**
+ * ClassifyObject(const std::vector<cell_coord> &cells, int max_period)
+ * Runs an object on an empty board of its own until its shape comes back,
+ * and returns its object code (see SoupCensus)
+ */
+string ClassifyObject(const vector<cell_coord> &cells, int max_period) {
+  GameOfLife isolated = IsolatedBoard(cells, cells);
+  std::int64_t height = isolated.GetHeight();
+  std::int64_t width = isolated.GetWidth();
+  vector<cell_coord> placed = isolated.LiveCells();
+
+  // The code is taken from whichever phase gives the smallest string, so
+  // every phase of an object gets the same code
+  const string start_shape = ObjectRows(placed);
+  string best = CanonicalRows(placed);
+  for (int gen = 1; gen <= max_period; ++gen) {
+    isolated.NextNGenWithoutHistory(1);
+    vector<cell_coord> live = isolated.LiveCells();
+    bool escaped = live.empty();
+    std::int64_t live_row = height, live_col = width;
+    for (const cell_coord &cell : live) {
+      escaped = escaped || cell.first == 0 || cell.second == 0 ||
+                cell.first == height - 1 || cell.second == width - 1;
+      live_row = std::min(live_row, cell.first);
+      live_col = std::min(live_col, cell.second);
+    }
+    if (escaped) {
+      // Died, or grew to the edge of the isolated board
+      break;
+    }
+    if (ObjectRows(live) == start_shape) {
+      bool moved = live_row != kIsolationMargin || live_col != kIsolationMargin;
+      if (moved) {
+        return "xq" + to_string(gen) + "_" + best;
+      }
+      if (gen == 1) {
+        return "xs" + to_string(cells.size()) + "_" + best;
+      }
+      return "xp" + to_string(gen) + "_" + best;
+    }
+    best = std::min(best, CanonicalRows(live));
+  }
+  // Objects that only persist because of something nearby
+  return "zz_" + CanonicalRows(cells);
+}
+
+/**
+ * ClassifyCluster(const std::vector<cell_coord> &cells, int max_period)
+ * Returns the object codes for a cluster of nearby cells. Its 8-connected
+ * pieces are classified separately if, run together, they evolve exactly as
+ * they do apart for max_period generations; otherwise the cluster is one
+ * object
+ */
+vector<string> ClassifyCluster(const vector<cell_coord> &cells,
+                               int max_period) {
+  vector<vector<cell_coord>> pieces = SplitComponents(cells);
+  bool independent = pieces.size() > 1;
+  if (independent) {
+    GameOfLife together = IsolatedBoard(cells, cells);
+    vector<GameOfLife> apart;
+    for (const vector<cell_coord> &piece : pieces) {
+      apart.push_back(IsolatedBoard(piece, cells));
+    }
+    for (int gen = 1; gen <= max_period && independent; ++gen) {
+      together.NextNGenWithoutHistory(1);
+      GameOfLife combined = together;
+      combined.ClearCells(together.LiveCells());
+      for (GameOfLife &piece : apart) {
+        piece.NextNGenWithoutHistory(1);
+        combined |= piece;
+      }
+      independent = combined.Equals(together);
+    }
+  }
+
+  vector<string> codes;
+  if (!independent) {
+    codes.push_back(ClassifyObject(cells, max_period));
+    return codes;
+  }
+  for (const vector<cell_coord> &piece : pieces) {
+    codes.push_back(ClassifyObject(piece, max_period));
+  }
+  return codes;
+}
+} // namespace
+
+SoupCensus::SoupCensus(const census_options &options)
+    : SoupCensus(options, this->own_table_) {}
+
+SoupCensus::SoupCensus(const census_options &options,
+                       TranspositionTable &table)
+    : options_(options), table_(&table) {
+  if (options.width <= 0 || options.height <= 0) {
+    throw(runtime_error("Error in SoupCensus constructor: soup width and "
+                        "height must both be positive"));
+  }
+  if (options.density < 0.0 || options.density > 1.0) {
+    throw(runtime_error("Error in SoupCensus constructor: density must be "
+                        "between 0 and 1"));
+  }
+  if (options.soup_count < 0 || options.max_generations <= 0 ||
+      options.thread_count < 0) {
+    throw(runtime_error("Error in SoupCensus constructor: soup count and "
+                        "thread count cannot be negative and max generations "
+                        "must be positive"));
+  }
+}
+
+census_report SoupCensus::Run() {
+  int thread_count = this->options_.thread_count;
+  if (thread_count == 0) {
+    thread_count = std::max(1u, thread::hardware_concurrency());
+  }
+
+  census_report total;
+  mutex total_mutex;
+  atomic<long> next_soup(0);
+  auto start = chrono::steady_clock::now();
+
+  // Each worker claims soups one at a time and keeps its own tally so that
+  // the only shared writes are the claim counter and the final merge
+  auto worker = [&]() {
+    census_report local;
+    for (long soup = next_soup++; soup < this->options_.soup_count;
+         soup = next_soup++) {
+      RunSoup(this->options_.seed + soup, local);
+    }
+    lock_guard<mutex> lock(total_mutex);
+    total.soups += local.soups;
+    total.duplicates += local.duplicates;
+    total.unstabilized += local.unstabilized;
+    for (const auto &[code, count] : local.objects) {
+      total.objects[code] += count;
+    }
+  };
+
+  vector<thread> workers;
+  for (int i = 1; i < thread_count; ++i) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (thread &running : workers) {
+    running.join();
+  }
+
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  total.seconds = elapsed.count();
+  if (total.seconds > 0.0) {
+    total.soups_per_second = total.soups / total.seconds;
+  }
+  return total;
+}
+
+GameOfLife SoupCensus::MakeSoup(std::int64_t width, std::int64_t height,
+                                double density,
+                                std::uint64_t seed) {
+  GameOfLife soup(width, height);
+  mt19937_64 rng(seed);
+  vector<cell_coord> live;
+  for (std::int64_t row = 0; row < height; ++row) {
+    for (std::int64_t col = 0; col < width; ++col) {
+      // Use the top 53 bits so the result is identical on every platform
+      double sample = static_cast<double>(rng() >> 11) / 9007199254740992.0;
+      if (sample < density) {
+        live.emplace_back(row, col);
+      }
+    }
+  }
+  soup.SetCells(live);
+  return soup;
+}
+
+void SoupCensus::RunSoup(std::uint64_t seed, census_report &report) {
+  GameOfLife board = MakeSoup(this->options_.width, this->options_.height,
+                              this->options_.density, seed);
+  ++report.soups;
+
+  // Boards of this soup to record in the table, as their Hash(),
+  // VerifyHash() and generation
+  vector<tuple<std::uint64_t, std::uint64_t, int>> checkpoints;
+  // Generation at which each state was first seen
+  unordered_map<std::uint64_t, int> seen;
+  board_outcome outcome;
+  bool finished = false;
+
+  for (int gen = 0; gen <= this->options_.max_generations; ++gen) {
+    if (gen > 0) {
+      board.NextNGenWithoutHistory(1);
+    }
+    std::uint64_t hash = board.Hash();
+
+    if (this->table_->Lookup(hash, outcome) &&
+        outcome.verify_hash == board.VerifyHash()) {
+      // Another soup already ran on from this board
+      ++report.duplicates;
+      outcome.stabilization_generation += gen;
+      finished = true;
+      break;
+    }
+
+    auto [first_seen, inserted] = seen.emplace(hash, gen);
+    if (!inserted) {
+      // Confirm the repeat so that a hash collision cannot end the soup
+      int period = gen - first_seen->second;
+      GameOfLife probe = board;
+      probe.NextNGenWithoutHistory(period);
+      if (probe.Equals(board)) {
+        outcome = {period, first_seen->second, FindObjects(board, period)};
+        checkpoints.emplace_back(hash, board.VerifyHash(),
+                                 outcome.stabilization_generation);
+        finished = true;
+        break;
+      }
+      first_seen->second = gen;
+    }
+    if (gen % kCheckpointInterval == 0) {
+      checkpoints.emplace_back(hash, board.VerifyHash(), gen);
+    }
+  }
+
+  if (!finished) {
+    ++report.unstabilized;
+    return;
+  }
+  for (const string &code : outcome.objects) {
+    ++report.objects[code];
+  }
+  for (const auto &[hash, verify_hash, checkpoint_gen] : checkpoints) {
+    board_outcome recorded = outcome;
+    recorded.stabilization_generation =
+        std::max(0, outcome.stabilization_generation - checkpoint_gen);
+    recorded.verify_hash = verify_hash;
+    this->table_->Insert(hash, recorded);
+  }
+}
+
+vector<string> SoupCensus::FindObjects(const GameOfLife &board, int period) {
+  vector<string> codes;
+  for (const vector<cell_coord> &cells : FindClusters(board)) {
+    // On its own an object repeats at least as often as the whole board
+    vector<string> cluster_codes = ClassifyCluster(cells, period);
+    codes.insert(codes.end(), cluster_codes.begin(), cluster_codes.end());
+  }
+  return codes;
+}
+
+std::ostream &GOL::operator<<(ostream &os, const census_report &report) {
+  os << "{\"soups\": " << report.soups
+     << ", \"duplicates\": " << report.duplicates
+     << ", \"unstabilized\": " << report.unstabilized
+     << ", \"seconds\": " << report.seconds
+     << ", \"soups_per_second\": " << report.soups_per_second
+     << ", \"objects\": {";
+  bool first = true;
+  for (const auto &[code, count] : report.objects) {
+    os << (first ? "" : ", ") << '"' << code << "\": " << count;
+    first = false;
+  }
+  os << "}}";
+  return os;
+}
@@ -0,0 +1,208 @@
+#ifndef SoupCensus_H_DEFINED
+#define SoupCensus_H_DEFINED
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "game_of_life.h"
+#include "transposition_table.h"
+
+namespace GOL {
+/**
+ * struct census_options
+ *
+ * This struct stores the settings for a random-soup census run.
+ */
+struct census_options {
+  /**
+   * int64_t width, the number of columns in every soup
+   */
+  std::int64_t width = 16;
+
+  /**
+   * int64_t height, the number of rows in every soup
+   */
+  std::int64_t height = 16;
+
+  /**
+   * double density, the probability that each cell of a soup starts alive
+   */
+  double density = 0.5;
+
+  /**
+   * uint64_t seed, the seed of the first soup. Soup i is generated from
+   * seed + i, so any soup can be reproduced on its own with MakeSoup
+   */
+  std::uint64_t seed = 0;
+
+  /**
+   * long soup_count, the number of soups to run
+   */
+  long soup_count = 1000;
+
+  /**
+   * int max_generations, soups that have not repeated a state after this many
+   * generations are counted as unstabilized
+   */
+  int max_generations = 10000;
+
+  /**
+   * int thread_count, the number of worker threads. 0 uses every hardware
+   * thread
+   */
+  int thread_count = 0;
+};
+
+/**
+ * struct census_report
+ *
+ * This struct stores the aggregated result of a census run.
+ */
+struct census_report {
+  /**
+   * long soups, the number of soups that were generated
+   */
+  long soups = 0;
+
+  /**
+   * long duplicates, soups finished early because they reached a board whose
+   * outcome was already in the transposition table. Their objects are still
+   * counted, from the recorded outcome
+   */
+  long duplicates = 0;
+
+  /**
+   * long unstabilized, soups that did not repeat within max_generations
+   */
+  long unstabilized = 0;
+
+  /**
+   * double seconds, the wall-clock duration of the run
+   */
+  double seconds = 0.0;
+
+  /**
+   * double soups_per_second, soups divided by seconds
+   */
+  double soups_per_second = 0.0;
+
+  /**
+   * std::map<std::string, long> objects, the number of times each final
+   * object was seen, keyed by its object code (see SoupCensus)
+   */
+  std::map<std::string, long> objects;
+};
+
+/**
+ * class SoupCensus
+ *
+ * This class runs large numbers of seeded random soups until they repeat a
+ * state, then splits each final board into objects and tallies them. Live
+ * cells within two rows and columns of each other (wrapping around the
+ * board) are clustered, since they may interact. A cluster's 8-connected
+ * pieces are separate objects if they evolve the same together as apart;
+ * otherwise the cluster is one object. Soups are spread over worker threads
+ * and the counts are merged at the end.
+ *
+ * Soups step without rollback history. A repeated Hash() is only accepted as
+ * a cycle once stepping the board by the candidate period gives an Equals
+ * board. The soup, every 32nd generation and the final cycle are recorded in
+ * the transposition table with their objects and VerifyHash(), so any later
+ * soup reaching one of those boards stops there and reuses the recorded
+ * objects. A table entry whose VerifyHash() differs belongs to another board
+ * with the same Hash() and is ignored.
+ *
+ * Each object is run on an empty board of its own until its shape comes
+ * back, which gives its own period and tells whether it moved. Object codes
+ * are "xs<cells>_<rows>" for still lifes, "xp<period>_<rows>" for
+ * oscillators, "xq<period>_<rows>" for spaceships and "zz_<rows>" for
+ * objects that die or keep changing on their own. <rows> is the object's
+ * bounding box written as rows of '*' and '.' separated by '/', taken from
+ * whichever phase, rotation and reflection gives the smallest string, so an
+ * object always gets the same code.
+ *
+ * @author Trevor Chartier
+ */
+class SoupCensus {
+  /**
+   * census_options options_, the settings for every run
+   */
+  census_options options_;
+
+  /**
+   * TranspositionTable *table_, the table shared with other searches, or
+   * own_table_ if none was given
+   */
+  TranspositionTable *table_;
+
+  /**
+   * TranspositionTable own_table_, used when no table is passed in
+   */
+  TranspositionTable own_table_;
+
+public:
+  /**
+   * No default constructor
+   */
+  SoupCensus() = delete;
+
+  /**
+   * SoupCensus(const census_options &options)
+   * Creates a census with its own transposition table
+   *
+   * @throws Runtime Error if the options are invalid
+   */
+  SoupCensus(const census_options &options);
+
+  /**
+   * SoupCensus(const census_options &options, TranspositionTable &table)
+   * Creates a census that records and skips soups using a shared table
+   *
+   * @throws Runtime Error if the options are invalid
+   */
+  SoupCensus(const census_options &options, TranspositionTable &table);
+
+  /**
+   * census_report Run()
+   * Runs options.soup_count soups across the worker threads and returns the
+   * merged tally
+   */
+  census_report Run();
+
+  /**
+   * GameOfLife MakeSoup(int64_t width, int64_t height, double density,
+   * uint64_t seed)
+   * Generates the random soup for seed. The same arguments always produce the
+   * same board
+   */
+  static GameOfLife MakeSoup(std::int64_t width, std::int64_t height,
+                             double density, std::uint64_t seed);
+
+private:
+  /**
+   * RunSoup(std::uint64_t seed, census_report &report)
+   * Runs one soup to completion and adds its objects to report
+   */
+  void RunSoup(std::uint64_t seed, census_report &report);
+
+  /**
+   * FindObjects(const GameOfLife &board, int period)
+   * Splits a final board with the given period into objects and returns
+   * their codes
+   */
+  static std::vector<std::string> FindObjects(const GameOfLife &board,
+                                              int period);
+};
+
+/**
+ * @brief Write a census report to ostream as a JSON object
+ *
+ * Writes soups, duplicates, unstabilized, seconds, soups_per_second and an
+ * "objects" map from object code to count
+ */
+std::ostream &operator<<(std::ostream &os, const census_report &report);
+} // namespace GOL
+
+#endif
@@ -0,0 +1,231 @@
+#include "streaming_evolver.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace GOL;
+//@author Trevor Chartier
+
+namespace {
+/**
+ * struct board_file
+ *
+ * Describes where the rows of a board file start and how long they are.
+ */
+struct board_file {
+  std::int64_t width;
+  std::int64_t height;
+  std::streamoff data_start;
+};
+
+/**
+ * OpenBoardFile(const std::string &filename, std::ifstream &file)
+ * Opens a board file, reads its header and checks that every row has
+ * exactly width cells
+ */
+board_file OpenBoardFile(const string &filename, ifstream &file) {
+  file.open(filename, ios::binary);
+  if (!file) {
+    throw(runtime_error("File Not Found: " + filename));
+  }
+  board_file board;
+  string header;
+  getline(file, header);
+  istringstream header_in(header);
+  if (!(header_in >> board.width >> board.height) || board.width <= 0 ||
+      board.height <= 0) {
+    throw(runtime_error("Invalid File Format: " + filename +
+                        " Is not in a valid format. Please include the width "
+                        "and height of gameboard"));
+  }
+  board.data_start = file.tellg();
+  file.seekg(0, ios::end);
+  std::streamoff expected =
+      board.data_start + board.height * (board.width + 1);
+  if (file.tellg() != expected) {
+    throw(runtime_error("Invalid File Format: " + filename +
+                        " Every row must hold exactly " +
+                        to_string(board.width) + " cells followed by a "
+                        "newline to be streamed"));
+  }
+  return board;
+}
+
+/**
+ * CheckDistinctFiles(const std::string &in_filename,
+ * const std::string &out_filename, const std::string &function)
+ * Throws if out_filename names the same file as in_filename, which would be
+ * truncated before it is read
+ */
+void CheckDistinctFiles(const string &in_filename, const string &out_filename,
+                        const string &function) {
+  error_code error;
+  if (in_filename == out_filename ||
+      filesystem::equivalent(in_filename, out_filename, error)) {
+    throw(runtime_error("Error in " + function + ": the output file " +
+                        out_filename + " is the same file as the input"));
+  }
+}
+
+/**
+ * ReadRows(std::ifstream &file, const board_file &board, int64_t first_row,
+ * int64_t rows)
+ * Reads rows whole rows, newlines included, starting at first_row
+ */
+vector<char> ReadRows(ifstream &file, const board_file &board,
+                      std::int64_t first_row, std::int64_t rows) {
+  vector<char> buffer(rows * (board.width + 1));
+  file.seekg(board.data_start + first_row * (board.width + 1));
+  if (!file.read(buffer.data(), buffer.size())) {
+    throw(runtime_error("Error in StreamNextGen: the board file could not be "
+                        "read"));
+  }
+  return buffer;
+}
+
+/**
+ * StepRow(const char *up, const char *mid, const char *down, int64_t width,
+ * std::vector<int> &column_sums, char *out)
+ * Writes the next generation of row mid, given the rows above and below it,
+ * followed by a newline
+ */
+void StepRow(const char *up, const char *mid, const char *down,
+             std::int64_t width, vector<int> &column_sums, char *out) {
+  for (std::int64_t col = 0; col < width; ++col) {
+    column_sums[col] = (up[col] == '*') + (mid[col] == '*') +
+                       (down[col] == '*');
+  }
+  for (std::int64_t col = 0; col < width; ++col) {
+    std::int64_t left = (col == 0) ? width - 1 : col - 1;
+    std::int64_t right = (col == width - 1) ? 0 : col + 1;
+    // The neighborhood sum includes the cell itself
+    int total = column_sums[left] + column_sums[col] + column_sums[right];
+    bool alive = total == 3 || (total == 4 && mid[col] == '*');
+    out[col] = alive ? '*' : '-';
+  }
+  out[width] = '\n';
+}
+} // namespace
+
+void GOL::StreamNextGen(const string &in_filename, const string &out_filename,
+                        std::int64_t band_rows) {
+  if (band_rows <= 0) {
+    throw(runtime_error("Error in StreamNextGen: band_rows must be positive"));
+  }
+  ifstream in;
+  board_file board = OpenBoardFile(in_filename, in);
+  CheckDistinctFiles(in_filename, out_filename, "StreamNextGen");
+  ofstream out(out_filename, ios::binary | ios::trunc);
+  if (!out) {
+    throw(runtime_error("File could not be opened for writing: " +
+                        out_filename));
+  }
+  out << board.width << ' ' << board.height << '\n';
+
+  band_rows = std::min(band_rows, board.height);
+  std::int64_t stride = board.width + 1;
+  vector<int> column_sums(board.width);
+
+  // The row above band 0 is the last row, the row below the last band is row 0
+  vector<char> above = ReadRows(in, board, board.height - 1, 1);
+  vector<char> band = ReadRows(in, board, 0, band_rows);
+  vector<char> first_row(band.begin(), band.begin() + stride);
+  vector<char> next_band;
+  vector<char> stepped;
+
+  for (std::int64_t start = 0; start < board.height; start += band_rows) {
+    std::int64_t rows = static_cast<std::int64_t>(band.size()) / stride;
+    std::int64_t next_start = start + rows;
+
+    // Read the following band while this one is being computed
+    future<vector<char>> prefetch;
+    if (next_start < board.height) {
+      std::int64_t next_rows = std::min(band_rows, board.height - next_start);
+      prefetch = async(launch::async, [&in, &board, next_start, next_rows]() {
+        return ReadRows(in, board, next_start, next_rows);
+      });
+    }
+
+    stepped.resize(band.size());
+    for (std::int64_t row = 0; row + 1 < rows; ++row) {
+      const char *up = (row == 0) ? above.data() : &band[(row - 1) * stride];
+      StepRow(up, &band[row * stride], &band[(row + 1) * stride], board.width,
+              column_sums, &stepped[row * stride]);
+    }
+
+    // The last row of the band needs the first row of the next band
+    if (prefetch.valid()) {
+      next_band = prefetch.get();
+    } else {
+      next_band = first_row;
+    }
+    std::int64_t last = rows - 1;
+    const char *up = (last == 0) ? above.data() : &band[(last - 1) * stride];
+    StepRow(up, &band[last * stride], next_band.data(), board.width,
+            column_sums, &stepped[last * stride]);
+
+    if (!out.write(stepped.data(), stepped.size())) {
+      throw(runtime_error("Error in StreamNextGen: could not write to " +
+                          out_filename));
+    }
+    above.assign(band.begin() + last * stride, band.end());
+    band.swap(next_band);
+  }
+  // Buffered rows are only written out when the file is closed
+  out.close();
+  if (!out) {
+    throw(runtime_error("Error in StreamNextGen: could not write to " +
+                        out_filename));
+  }
+}
+
+void GOL::StreamNextNGen(const string &in_filename, const string &out_filename,
+                         int n, std::int64_t band_rows) {
+  if (n < 0) {
+    throw(runtime_error("Error in StreamNextNGen: the number of generations "
+                        "cannot be negative"));
+  }
+  CheckDistinctFiles(in_filename, out_filename, "StreamNextNGen");
+  if (n == 0) {
+    // Re-stream the board unchanged so out_filename always ends up written
+    ifstream in;
+    OpenBoardFile(in_filename, in);
+    in.seekg(0);
+    ofstream out(out_filename, ios::binary | ios::trunc);
+    if (!out) {
+      throw(runtime_error("File could not be opened for writing: " +
+                          out_filename));
+    }
+    out << in.rdbuf();
+    out.close();
+    if (!out) {
+      throw(runtime_error("Error in StreamNextNGen: could not write to " +
+                          out_filename));
+    }
+    return;
+  }
+  // Alternate files so that the final generation lands in out_filename
+  string temp_filename = out_filename + ".tmp";
+  CheckDistinctFiles(in_filename, temp_filename, "StreamNextNGen");
+  string source = in_filename;
+  try {
+    for (int gen = n; gen > 0; --gen) {
+      string target = (gen % 2 == 1) ? out_filename : temp_filename;
+      StreamNextGen(source, target, band_rows);
+      source = target;
+    }
+  } catch (...) {
+    // Don't leave a half written intermediate generation behind
+    std::remove(temp_filename.c_str());
+    throw;
+  }
+  std::remove(temp_filename.c_str());
+}
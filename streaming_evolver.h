@@ -0,0 +1,57 @@
+#ifndef StreamingEvolver_H_DEFINED
+#define StreamingEvolver_H_DEFINED
+#include <cstdint>
+#include <string>
+
+namespace GOL {
+/**
+ * StreamNextGen(const std::string &in_filename,
+ * const std::string &out_filename, int64_t band_rows)
+ *
+ * @brief Calculates the next generation of a board file without loading the
+ * whole board into memory. Utilizes wrap around like GameOfLife::NextGen.
+ *
+ * The board is read in bands of band_rows rows. Only the band being computed,
+ * the next band (read ahead asynchronously while the current one is
+ * computed), the row above the current band and the first row of the board
+ * are held in memory. Each finished band is appended to out_filename, so both
+ * files are accessed with large sequential reads and writes.
+ *
+ * The input must be in the layout the GameOfLife file constructors read: a
+ * first line holding the width and height, then one line per row holding
+ * exactly width cells followed by '\n'. '*' is a live cell and any other
+ * character is dead. The output uses the same layout with '*' and '-', so it
+ * can be loaded with GameOfLife(filename). Printing a GameOfLife with
+ * operator<< does not produce this layout, since that output starts with a
+ * "Generation:" line.
+ *
+ * @throws Runtime Error if a file cannot be opened, is not in the layout
+ * above, cannot be completely written, out_filename is the same file as
+ * in_filename, or band_rows is not positive
+ *
+ * @param in_filename The board file holding the current generation
+ * @param out_filename The file to write the next generation to
+ * @param band_rows The number of rows to hold in each band
+ */
+void StreamNextGen(const std::string &in_filename,
+                   const std::string &out_filename, std::int64_t band_rows);
+
+/**
+ * StreamNextNGen(const std::string &in_filename,
+ * const std::string &out_filename, int n, int64_t band_rows)
+ *
+ * @brief Calculates generation n of a board file by streaming it n times.
+ * Intermediate generations alternate between out_filename and
+ * out_filename + ".tmp", which is removed afterwards, including when a
+ * generation fails part way. When n is 0 the board is copied unchanged.
+ *
+ * @throws Runtime Error under the same conditions as StreamNextGen, or if n
+ * is negative. Nothing is written if out_filename or its temporary file is
+ * the same file as in_filename
+ */
+void StreamNextNGen(const std::string &in_filename,
+                    const std::string &out_filename, int n,
+                    std::int64_t band_rows);
+} // namespace GOL
+
+#endif
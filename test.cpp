@@ -0,0 +1,333 @@
+#include "fixed_game_of_life.h"
+#include "game_of_life.h"
+#include "soup_census.h"
+#include "streaming_evolver.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace GOL;
+//@author Trevor Chartier
+
+// Behavior checks for the library. Each check compares a fast path against
+// a slow, obviously correct one. Run with "make test"
+
+namespace {
+int failures = 0;
+
+/**
+ * Check(bool condition, const std::string &what)
+ * Records a failure and reports what was being checked if condition is false
+ */
+void Check(bool condition, const string &what) {
+  if (!condition) {
+    cerr << "FAILED: " << what << '\n';
+    ++failures;
+  }
+}
+
+/**
+ * RandomBoard(int64_t width, int64_t height, unsigned percent,
+ * std::mt19937 &rng)
+ * Returns a board where each cell is alive with the given percent chance
+ */
+GameOfLife RandomBoard(std::int64_t width, std::int64_t height,
+                       unsigned percent, mt19937 &rng) {
+  GameOfLife board(width, height);
+  vector<cell_coord> live;
+  for (std::int64_t row = 0; row < height; ++row) {
+    for (std::int64_t col = 0; col < width; ++col) {
+      if (rng() % 100 < percent) {
+        live.emplace_back(row, col);
+      }
+    }
+  }
+  board.SetCells(live);
+  return board;
+}
+
+/**
+ * Wrap(int64_t value, int64_t size)
+ * Wraps an unbounded row or column back onto the board
+ */
+std::int64_t Wrap(std::int64_t value, std::int64_t size) {
+  return ((value % size) + size) % size;
+}
+
+/**
+ * Rebuilt(const GameOfLife &board)
+ * Returns a copy of board built cell by cell on a new board
+ */
+GameOfLife Rebuilt(const GameOfLife &board) {
+  GameOfLife copy(board.GetWidth(), board.GetHeight());
+  for (std::int64_t row = 0; row < board.GetHeight(); ++row) {
+    for (std::int64_t col = 0; col < board.GetWidth(); ++col) {
+      if (board.IsAlive(row, col)) {
+        copy.ToggleCell(row, col);
+      }
+    }
+  }
+  return copy;
+}
+
+/**
+ * Glider()
+ * Returns a 3x3 board holding a glider
+ */
+GameOfLife Glider() {
+  GameOfLife glider(3, 3);
+  vector<cell_coord> cells = {{0, 1}, {1, 2}, {2, 0}, {2, 1}, {2, 2}};
+  glider.SetCells(cells);
+  return glider;
+}
+
+void TestCountAlive(mt19937 &rng) {
+  for (int trial = 0; trial < 200; ++trial) {
+    std::int64_t width = 1 + rng() % 13, height = 1 + rng() % 11;
+    GameOfLife board = RandomBoard(width, height, 50, rng);
+    // Count once before and once after a step to catch a stale table
+    for (int step = 0; step < 2; ++step) {
+      std::int64_t row = rng() % height, col = rng() % width;
+      std::int64_t rows = rng() % (height + 1), cols = rng() % (width + 1);
+      std::int64_t expected = 0;
+      for (std::int64_t r = 0; r < rows; ++r) {
+        for (std::int64_t c = 0; c < cols; ++c) {
+          expected += board.IsAlive((row + r) % height, (col + c) % width);
+        }
+      }
+      Check(board.CountAlive(row, col, rows, cols) == expected,
+            "CountAlive matches a cell by cell count");
+      board.NextGen();
+    }
+  }
+}
+
+void TestHashAndEquals(mt19937 &rng) {
+  for (int trial = 0; trial < 100; ++trial) {
+    GameOfLife board = RandomBoard(1 + rng() % 20, 1 + rng() % 20, 40, rng);
+    board.NextNGen(1 + rng() % 5);
+    GameOfLife copy = Rebuilt(board);
+    Check(copy.Equals(board) && copy.Hash() == board.Hash() &&
+              copy.VerifyHash() == board.VerifyHash(),
+          "equal boards have equal hashes");
+    copy.ToggleCell(0);
+    Check(!copy.Equals(board) && copy.Hash() != board.Hash(),
+          "a toggled cell changes Equals and Hash");
+    copy.ToggleCell(0);
+    Check(copy.Equals(board) && copy.Hash() == board.Hash(),
+          "toggling back restores Equals and Hash");
+  }
+  GameOfLife wide(4, 2), tall(2, 4);
+  Check(!wide.Equals(tall) && wide.Hash() != tall.Hash(),
+        "boards of different shapes differ");
+}
+
+void TestTranslateAndPaste(mt19937 &rng) {
+  for (int trial = 0; trial < 100; ++trial) {
+    std::int64_t width = 1 + rng() % 13, height = 1 + rng() % 11;
+    GameOfLife board = RandomBoard(width, height, 50, rng);
+
+    GameOfLife moved = board;
+    std::int64_t d_row = static_cast<std::int64_t>(rng() % 41) - 20;
+    std::int64_t d_col = static_cast<std::int64_t>(rng() % 41) - 20;
+    moved.Translate(d_row, d_col);
+    bool translated = true;
+    for (std::int64_t row = 0; row < height; ++row) {
+      for (std::int64_t col = 0; col < width; ++col) {
+        translated = translated &&
+                     moved.IsAlive(Wrap(row + d_row, height),
+                                   Wrap(col + d_col, width)) ==
+                         board.IsAlive(row, col);
+      }
+    }
+    Check(translated, "Translate moves every cell with wrap around");
+
+    std::int64_t row = rng() % height, col = rng() % width;
+    GameOfLife pattern =
+        RandomBoard(1 + rng() % width, 1 + rng() % height, 50, rng);
+    GameOfLife pasted = board;
+    pasted.Paste(pattern, row, col, paste_mode::kXor);
+    bool matches = true;
+    for (std::int64_t r = 0; r < height; ++r) {
+      for (std::int64_t c = 0; c < width; ++c) {
+        std::int64_t p_row = Wrap(r - row, height);
+        std::int64_t p_col = Wrap(c - col, width);
+        bool expected = board.IsAlive(r, c);
+        if (p_row < pattern.GetHeight() && p_col < pattern.GetWidth()) {
+          expected = expected != pattern.IsAlive(p_row, p_col);
+        }
+        matches = matches && pasted.IsAlive(r, c) == expected;
+      }
+    }
+    Check(matches, "Paste with kXor wraps around the board edges");
+    Check(pasted.Hash() == Rebuilt(pasted).Hash(),
+          "Paste leaves the hash up to date");
+
+    GameOfLife self = board;
+    GameOfLife from_copy = board;
+    self.Paste(self, row, col, paste_mode::kOverwrite);
+    from_copy.Paste(GameOfLife(board), row, col, paste_mode::kOverwrite);
+    Check(self.Equals(from_copy), "Paste of a board onto itself");
+
+    GameOfLife other = RandomBoard(width, height, 50, rng);
+    Check(((board ^ other) ^ other).Equals(board), "XOR twice is identity");
+    Check(board.AndNot(other).Equals(board & -other), "AndNot is AND NOT");
+    GameOfLife filled = board;
+    filled.FillRect(row, col, height, width, true);
+    Check(filled.CountAlive(0, 0, height, width) == width * height,
+          "FillRect of the whole board");
+  }
+}
+
+void TestStepping(mt19937 &rng) {
+  GameOfLife start = RandomBoard(10, 10, 30, rng);
+  GameOfLife slow = start;
+  for (int gen = 0; gen < 250; ++gen) {
+    slow.NextGen();
+  }
+  GameOfLife fast = start;
+  fast.NextNGen(250);
+  Check(fast.Equals(slow) &&
+            fast.GetAvailableGens() == slow.GetAvailableGens(),
+        "NextNGen matches repeated NextGen");
+  for (int back = 1; back <= 100; ++back) {
+    Check((fast - back).Equals(slow - back),
+          "rollback after NextNGen matches rollback after NextGen");
+  }
+
+  GameOfLife unsaved = start;
+  unsaved.NextNGenWithoutHistory(250);
+  Check(unsaved.Equals(slow) && unsaved.GetAvailableGens() == 0,
+        "NextNGenWithoutHistory keeps no history");
+
+  GameOfLife until = start;
+  int stepped =
+      until.StepUntil(chrono::steady_clock::time_point::max(), 30);
+  Check(stepped == 30 && until.Equals(start + 30) &&
+            until.GetAvailableGens() == 30,
+        "StepUntil with no deadline steps max_gens generations");
+
+  CancellationToken token;
+  token.Cancel();
+  GameOfLife cancelled = start;
+  Check(cancelled.StepFor(chrono::seconds(10), token) == 0 &&
+            cancelled.Equals(start),
+        "a cancelled token stops StepFor before any generation");
+
+  GameOfLife fixed_start = RandomBoard(16, 12, 30, rng);
+  FixedGameOfLife<16, 12> fixed(fixed_start);
+  fixed += 37;
+  ostringstream fixed_text, dynamic_text;
+  fixed_text << fixed;
+  dynamic_text << fixed_start + 37;
+  Check(fixed_text.str() == dynamic_text.str(),
+        "FixedGameOfLife matches GameOfLife");
+}
+
+void TestFindPattern(mt19937 &rng) {
+  GameOfLife glider = Glider();
+  for (int trial = 0; trial < 100; ++trial) {
+    std::int64_t width = 5 + rng() % 30, height = 5 + rng() % 20;
+    GameOfLife board = RandomBoard(width, height, 15, rng);
+    board.Paste(glider, rng() % height, rng() % width, paste_mode::kOverwrite);
+    size_t expected = 0;
+    for (std::int64_t row = 0; row < height; ++row) {
+      for (std::int64_t col = 0; col < width; ++col) {
+        bool found = true;
+        for (std::int64_t r = 0; r < 3; ++r) {
+          for (std::int64_t c = 0; c < 3; ++c) {
+            found = found && board.IsAlive((row + r) % height,
+                                           (col + c) % width) ==
+                                 glider.IsAlive(r, c);
+          }
+        }
+        expected += found;
+      }
+    }
+    Check(board.FindPattern(glider, kIdentity).size() == expected,
+          "FindPattern finds every match");
+  }
+  GameOfLife board(20, 20);
+  board.Paste(glider, 5, 7, paste_mode::kOverwrite);
+  board.NextNGen(4);
+  vector<pattern_match> found = board.FindPattern(glider, kAllOrientations,
+                                                  true);
+  Check(found.size() == 1 && found[0].row == 6 && found[0].col == 8 &&
+            found[0].orientation == kIdentity,
+        "an isolated glider moves one cell diagonally every 4 generations");
+}
+
+void TestStreaming(mt19937 &rng) {
+  filesystem::path dir = filesystem::temp_directory_path();
+  string in_name = (dir / "gol_test_board.txt").string();
+  string out_name = (dir / "gol_test_out.txt").string();
+  std::int64_t width = 37, height = 23;
+  {
+    ofstream file(in_name);
+    file << width << ' ' << height << '\n';
+    for (std::int64_t row = 0; row < height; ++row) {
+      for (std::int64_t col = 0; col < width; ++col) {
+        file << (rng() % 3 == 0 ? '*' : '-');
+      }
+      file << '\n';
+    }
+  }
+  for (std::int64_t band_rows : {1, 2, 5, 7, 23, 100}) {
+    StreamNextNGen(in_name, out_name, 5, band_rows);
+    Check(GameOfLife(out_name).Equals(GameOfLife(in_name, 5)),
+          "streamed generations match in-memory generations");
+  }
+  StreamNextNGen(in_name, out_name, 0, 4);
+  Check(GameOfLife(out_name).Equals(GameOfLife(in_name)),
+        "streaming zero generations copies the board");
+  Check(!filesystem::exists(out_name + ".tmp"),
+        "streaming removes its temporary file");
+  filesystem::remove(in_name);
+  filesystem::remove(out_name);
+}
+
+void TestCensus() {
+  census_options options;
+  options.soup_count = 200;
+  options.seed = 42;
+  options.thread_count = 4;
+  SoupCensus census(options);
+  census_report first = census.Run();
+  census_report again = census.Run();
+  options.thread_count = 1;
+  census_report single = SoupCensus(options).Run();
+  Check(first.soups == 200 && first.unstabilized == 0,
+        "every census soup stabilizes");
+  Check(first.objects == single.objects,
+        "the census counts the same objects on any number of threads");
+  Check(again.objects == first.objects && again.duplicates == 200,
+        "a repeated census reuses every table entry");
+  Check(first.objects.count("xs4_**/**") == 1 &&
+            first.objects.count("xp2_***") == 1,
+        "the census finds blocks and blinkers");
+}
+} // namespace
+
+int main() {
+  mt19937 rng(1);
+  TestCountAlive(rng);
+  TestHashAndEquals(rng);
+  TestTranslateAndPaste(rng);
+  TestStepping(rng);
+  TestFindPattern(rng);
+  TestStreaming(rng);
+  TestCensus();
+  if (failures > 0) {
+    cerr << failures << " check(s) failed\n";
+    return 1;
+  }
+  cout << "All tests passed\n";
+  return 0;
+}
@@ -0,0 +1,43 @@
+#include "transposition_table.h"
+
+#include <mutex>
+#include <shared_mutex>
+
+using namespace std;
+using namespace GOL;
+//@author Trevor Chartier
+
+bool TranspositionTable::Lookup(std::uint64_t hash,
+                                board_outcome &outcome) const {
+  const shard &target = this->shards_[hash % kShardCount];
+  shared_lock lock(target.mutex);
+  auto found = target.entries.find(hash);
+  if (found == target.entries.end()) {
+    return false;
+  }
+  outcome = found->second;
+  return true;
+}
+
+bool TranspositionTable::Insert(std::uint64_t hash,
+                                const board_outcome &outcome) {
+  shard &target = this->shards_[hash % kShardCount];
+  unique_lock lock(target.mutex);
+  return target.entries.emplace(hash, outcome).second;
+}
+
+size_t TranspositionTable::Size() const {
+  size_t size = 0;
+  for (const shard &target : this->shards_) {
+    shared_lock lock(target.mutex);
+    size += target.entries.size();
+  }
+  return size;
+}
+
+void TranspositionTable::Clear() {
+  for (shard &target : this->shards_) {
+    unique_lock lock(target.mutex);
+    target.entries.clear();
+  }
+}
@@ -0,0 +1,128 @@
+#ifndef TranspositionTable_H_DEFINED
+#define TranspositionTable_H_DEFINED
+#include <array>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace GOL {
+/**
+ * struct board_outcome
+ *
+ * This struct stores what is known about where a GameOfLife board ends up
+ * once it has been run until it repeats.
+ */
+struct board_outcome {
+  /**
+   * int period, the number of generations in the final cycle (1 for a still
+   * life or an empty board)
+   */
+  int period;
+
+  /**
+   * int stabilization_generation, the number of generations after this board
+   * at which it first enters its final cycle (0 if it is already in it)
+   */
+  int stabilization_generation;
+
+  /**
+   * std::vector<std::string> objects, the codes of the objects left in the
+   * final cycle, if the search that recorded the outcome classified them
+   */
+  std::vector<std::string> objects;
+
+  /**
+   * uint64_t verify_hash, the GameOfLife::VerifyHash() of the board the
+   * outcome was recorded for, or 0 if the search did not store it. A lookup
+   * for a board with a different VerifyHash() hit an entry of another board
+   * whose Hash() collides with it
+   */
+  std::uint64_t verify_hash = 0;
+};
+
+/**
+ * class TranspositionTable
+ *
+ * This class maps GameOfLife::Hash() values to known board outcomes so that
+ * searches can skip boards whose state has already been explored. It is safe
+ * to share one table between threads: the table is split into shards, each
+ * guarded by its own reader/writer lock, so concurrent lookups never block
+ * each other and concurrent inserts only contend when they land in the same
+ * shard.
+ *
+ * Entries are keyed by hash alone, so two different boards whose hashes
+ * collide share an entry. Searches that must tell such boards apart store
+ * a second hash in board_outcome::verify_hash and compare it on lookup.
+ *
+ * @author Trevor Chartier
+ */
+class TranspositionTable {
+  /**
+   * int kShardCount, the number of independently locked shards
+   */
+  static constexpr int kShardCount = 64;
+
+  /**
+   * struct shard, one lock and the entries it guards
+   */
+  struct shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::uint64_t, board_outcome> entries;
+  };
+
+  /**
+   * std::array<shard, kShardCount> shards_, the shards of the table. A hash
+   * always lives in shards_[hash % kShardCount]
+   */
+  std::array<shard, kShardCount> shards_;
+
+public:
+  /**
+   * TranspositionTable()
+   * Default constructor, creates an empty table
+   */
+  TranspositionTable() = default;
+
+  /**
+   * Tables hold locks and are meant to be shared by reference, not copied
+   */
+  TranspositionTable(const TranspositionTable &other) = delete;
+  TranspositionTable &operator=(const TranspositionTable &other) = delete;
+
+  /**
+   * bool Lookup(uint64_t hash, board_outcome &outcome)
+   * Looks up the outcome recorded for hash
+   *
+   * @param hash A value returned by GameOfLife::Hash()
+   * @param outcome Set to the recorded outcome if one exists
+   *
+   * @return true if an outcome was recorded for hash, otherwise false
+   */
+  bool Lookup(std::uint64_t hash, board_outcome &outcome) const;
+
+  /**
+   * bool Insert(uint64_t hash, const board_outcome &outcome)
+   * Records the outcome for hash. If an outcome is already recorded, it is
+   * kept and the table is left unchanged
+   *
+   * @return true if the outcome was inserted, false if hash was already known
+   */
+  bool Insert(std::uint64_t hash, const board_outcome &outcome);
+
+  /**
+   * size_t Size()
+   * Returns the number of hashes recorded in the table
+   */
+  size_t Size() const;
+
+  /**
+   * void Clear()
+   * Removes every entry from the table
+   */
+  void Clear();
+};
+} // namespace GOL
+
+#endif